@@ -0,0 +1,202 @@
+#ifndef BITS_ALARM_H
+#define BITS_ALARM_H
+
+#include <avr/pgmspace.h>
+
+#include "types.hpp"
+#include "interrupts.hpp"
+#include "pitch.hpp"
+
+/// @brief Helper classes & functions.
+namespace Bits {
+	/// @brief Non-blocking buzzer pattern player.
+	/// @details Patterns are stored in flash. Each note is ended by a one-shot Timer1 interrupt, and the next step is started
+	/// from the loop, by `update()`, once its deadline has passed. Timer1 only runs while a note sounds, so the MCU may power down
+	/// in the gaps, and the tone generator is only touched when a note starts or ends.
+	struct Alarm {
+		/// @brief Pattern step.
+		struct PACKED Step {
+			/// @brief Note frequency, in Hz. `0` for a rest.
+			uint16 note;
+			/// @brief Note duration, in milliseconds.
+			uint16 duration;
+			/// @brief Silence after the note, in milliseconds.
+			uint16 gap;
+		};
+
+		/// @brief Pattern definition.
+		struct PACKED Definition {
+			/// @brief Pattern steps, stored in flash.
+			Step const*	steps;
+			/// @brief Step count.
+			uint8		count;
+			/// @brief Times to play the pattern. `0` repeats it forever.
+			uint8		repeat;
+		};
+
+		/// @brief Available patterns.
+		enum class Pattern: uint8 {
+			BAP_NONE,
+			BAP_OK,
+			BAP_TEMPERATURE,
+			BAP_HUMIDITY,
+			BAP_LUMINOSITY,
+		};
+
+		/// @brief Constructs the alarm.
+		/// @param pin Buzzer pin.
+		Alarm(avr_pin const pin): pin(pin) {}
+
+		/// @brief Initializes the alarm.
+		void begin() {
+			pinMode(pin, OUTPUT);
+		}
+
+		/// @brief Plays a pattern. Does nothing if it is already playing.
+		/// @param pattern Pattern to play.
+		void play(Pattern const pattern) {
+			if (pattern == current) return;
+			uint8 const sreg = SREG;
+			cli();
+			current = pattern;
+			if (acknowledged != pattern)
+				acknowledged = Pattern::BAP_NONE;
+			restart();
+			SREG = sreg;
+		}
+
+		/// @brief Silences the current pattern until a different one is played.
+		void acknowledge() {
+			uint8 const sreg = SREG;
+			cli();
+			acknowledged = current;
+			restart();
+			SREG = sreg;
+		}
+
+		/// @brief Silences (or unsilences) all patterns.
+		/// @param state Whether to silence the alarm.
+		void silence(bool const state) {
+			uint8 const sreg = SREG;
+			cli();
+			muted = state;
+			restart();
+			SREG = sreg;
+		}
+
+		/// @brief Starts the next step, if it is due.
+		void update() {
+			if (!waiting() || static_cast<int32>(millis() - due) < 0) return;
+			if (++index >= definition.count) {
+				index = 0;
+				if (definition.repeat && !--repeatsLeft) {
+					active = false;
+					return;
+				}
+			}
+			startStep();
+		}
+
+		/// @brief Returns whether the next step is waiting on `deadline()`.
+		bool waiting() const {return active && !sounding;}
+
+		/// @brief Returns when the next step is due (as in `millis()`).
+		uint32 deadline() const {return due;}
+
+		/// @brief Returns the pattern currently set to play.
+		Pattern playing() const {return current;}
+
+	private:
+		/// @brief Restarts the current pattern from its first step, if it is allowed to play.
+		void restart() {
+			PeriodicTimer::stop();
+			noTone(pin);
+			sounding = false;
+			active = (
+				!muted
+			&&	current != Pattern::BAP_NONE
+			&&	current != acknowledged
+			);
+			if (!active) return;
+			memcpy_P(&definition, &DEFINITIONS[static_cast<uint8>(current)], sizeof(Definition));
+			index		= 0;
+			repeatsLeft	= definition.repeat;
+			startStep();
+		}
+
+		/// @brief Starts the current step. A note is ended by the timer, a rest just pushes the deadline back.
+		void startStep() {
+			memcpy_P(&note, &definition.steps[index], sizeof(Step));
+			if (!note.note) {
+				due = millis() + note.duration + note.gap;
+				return;
+			}
+			tone(pin, note.note);
+			sounding = true;
+			PeriodicTimer::start<&Alarm::endNote>(note.duration * 1000ul, *this);
+		}
+
+		/// @brief Ends the current note, and stops the timer until the next one. Called from the timer interrupt.
+		void endNote() {
+			PeriodicTimer::stop();
+			noTone(pin);
+			due			= millis() + note.gap;
+			sounding	= false;
+		}
+
+		constexpr static Step const OK_STEPS[] PROGMEM = {
+			{NOTE_C5, 100, 900},
+		};
+
+		constexpr static Step const TEMPERATURE_STEPS[] PROGMEM = {
+			{NOTE_C6, 500, 500},
+		};
+
+		constexpr static Step const HUMIDITY_STEPS[] PROGMEM = {
+			{NOTE_A5, 150, 100},
+			{NOTE_A5, 150, 600},
+		};
+
+		constexpr static Step const LUMINOSITY_STEPS[] PROGMEM = {
+			{NOTE_E6, 100, 100},
+			{NOTE_E6, 100, 100},
+			{NOTE_E6, 100, 500},
+		};
+
+		/// @brief Pattern definitions, by `Pattern`.
+		constexpr static Definition const DEFINITIONS[] PROGMEM = {
+			{nullptr,			0,										0},
+			{OK_STEPS,			sizeof(OK_STEPS)			/ sizeof(Step),	0},
+			{TEMPERATURE_STEPS,	sizeof(TEMPERATURE_STEPS)	/ sizeof(Step),	0},
+			{HUMIDITY_STEPS,	sizeof(HUMIDITY_STEPS)		/ sizeof(Step),	0},
+			{LUMINOSITY_STEPS,	sizeof(LUMINOSITY_STEPS)	/ sizeof(Step),	0},
+		};
+
+		static_assert(sizeof(DEFINITIONS) / sizeof(Definition) == static_cast<uint8>(Pattern::BAP_LUMINOSITY) + 1);
+
+		/// @brief Buzzer pin.
+		avr_pin const		pin;
+		/// @brief Pattern set to play.
+		Pattern				current			= Pattern::BAP_NONE;
+		/// @brief Pattern silenced until a different one is played.
+		Pattern				acknowledged	= Pattern::BAP_NONE;
+		/// @brief Whether all patterns are silenced.
+		bool				muted			= false;
+		/// @brief Definition of the playing pattern.
+		Definition			definition;
+		/// @brief Current step.
+		Step				note;
+		/// @brief Current step index.
+		uint8				index			= 0;
+		/// @brief Repetitions left.
+		uint8				repeatsLeft		= 0;
+		/// @brief When the next step is due (as in `millis()`). Only meaningful while no note sounds.
+		volatile uint32		due				= 0;
+		/// @brief Whether the current step's note is playing.
+		volatile bool		sounding		= false;
+		/// @brief Whether a pattern is playing.
+		volatile bool		active			= false;
+	};
+}
+
+#endif
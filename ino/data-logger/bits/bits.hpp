@@ -1,15 +1,32 @@
 #ifndef BITS_H
 #define BITS_H
 
+#if __cplusplus < 201703L
+#error "The data logger needs C++17: build with compiler.cpp.extra_flags=-std=gnu++17 (avr-gcc 7.3 or later). See the README."
+#endif
+
 #include "types.hpp"
 #include "core.hpp"
+#include "units.hpp"
+#include "crc.hpp"
 #include "interrupts.hpp"
+#include "watchdog.hpp"
+#include "output.hpp"
+#include "power.hpp"
+#include "alarm.hpp"
 #include "databank.hpp"
+#include "retention.hpp"
+#include "wipe.hpp"
+#include "staging.hpp"
+#include "memory.hpp"
 #include "record.hpp"
+#include "layout.hpp"
 #include "clock.hpp"
 #include "sensor.hpp"
 #include "display.hpp"
 #include "parser.hpp"
+#include "channels.hpp"
+#include "filter.hpp"
 #include "datalogger.hpp"
 #include "logo.hpp"
 
@@ -0,0 +1,204 @@
+#ifndef BITS_CHANNELS_H
+#define BITS_CHANNELS_H
+
+#include "types.hpp"
+#include "alarm.hpp"
+#include "display.hpp"
+
+/// @brief Helper classes & functions.
+namespace Bits {
+	/// @brief Packed, heterogeneous list of values.
+	/// @tparam Ts Value types.
+	template <class... Ts>
+	struct PACKED Readings;
+
+	template <class T>
+	struct PACKED Readings<T> {
+		T				head;
+	};
+
+	template <class T, class... Ts>
+	struct PACKED Readings<T, Ts...> {
+		T				head;
+		Readings<Ts...>	tail;
+	};
+
+	/// @brief Compile-time sensor channel list.
+	/// @details Each channel type must provide:
+	/// - `Reading`: the (raw-domain) value type stored in logs;
+	/// - `InfoRecord`: its persistent configuration record type;
+	/// - `PAGES`: the amount of display pages it takes up;
+	/// - `INTERVAL`: the minimum time between samples, in milliseconds;
+	/// - A `(avr_pin, eeprom_address)` constructor;
+	/// - `begin()`, `update()`, `save()`, `revert()` & `valid()`, as for records;
+	/// - `apply()`: makes `check()` use the current configuration, which it keeps using until the next `apply()`;
+	/// - `bool consistent() const`: whether its configuration makes sense as a whole;
+	/// - `Reading sample()`: takes a reading;
+	/// - `bool measured(Reading const&) const`: whether a reading holds actual measurements, rather than a failed read;
+	/// - `Alarm::Pattern check(Reading const&) const`: evaluates a reading against the channel's thresholds;
+	/// - `String toString(Reading const&) const`: returns a reading as a string;
+	/// - `String toValues(Reading const&) const`: returns a reading's raw values, comma-separated;
+	/// - `void show(Display&, Reading const&, uint8 page) const`: shows a reading on the second display row.
+	///
+	/// Everything is resolved at compile time. There is no virtual dispatch and no heap allocation.
+	/// @tparam Cs Channel types.
+	template <class... Cs>
+	struct Channels;
+
+	/// @brief End of a channel list.
+	template <>
+	struct Channels<> {
+		constexpr static usize const	COUNT	= 0;
+		constexpr static uint8 const	PAGES		= 0;
+		constexpr static uint16 const	INTERVAL	= 0;
+		constexpr static uint32 const	SIZE		= 0;
+
+		Channels(eeprom_address const, avr_pin const* const) {}
+	};
+
+	template <class C, class... Cs>
+	struct Channels<C, Cs...> {
+		/// @brief Rest of the channel list.
+		using Tail = Channels<Cs...>;
+
+		/// @brief Readings of every channel, in order.
+		using Reading = Readings<typename C::Reading, typename Cs::Reading...>;
+
+		/// @brief Amount of channels.
+		constexpr static usize const	COUNT	= 1 + Tail::COUNT;
+		/// @brief Total amount of display pages.
+		constexpr static uint8 const	PAGES		= C::PAGES + Tail::PAGES;
+		/// @brief Minimum time between samples, in milliseconds. Set by the slowest channel.
+		constexpr static uint16 const	INTERVAL	= (C::INTERVAL > Tail::INTERVAL) ? C::INTERVAL : Tail::INTERVAL;
+		/// @brief Total EEPROM footprint of the channels' records.
+		constexpr static uint32 const	SIZE		= C::InfoRecord::SIZE + Tail::SIZE;
+
+		static_assert(PAGES > 0);
+
+		/// @brief Constructs the channels.
+		/// @param info EEPROM address of the first channel's record. The others follow back-to-back.
+		/// @param pins Pin of each channel, in order. Must hold `COUNT` pins.
+		Channels(eeprom_address const info, avr_pin const* const pins):
+			head(pins[0], info),
+			tail(info + C::InfoRecord::SIZE, pins + 1) {}
+
+		void begin() {
+			head.begin();
+			if constexpr (Tail::COUNT) tail.begin();
+		}
+
+		void update() {
+			head.update();
+			if constexpr (Tail::COUNT) tail.update();
+		}
+
+		void save() {
+			head.save();
+			if constexpr (Tail::COUNT) tail.save();
+		}
+
+		void revert() {
+			head.revert();
+			if constexpr (Tail::COUNT) tail.revert();
+		}
+
+		/// @brief Makes every channel's thresholds, as currently configured, the ones readings are checked against.
+		void apply() {
+			head.apply();
+			if constexpr (Tail::COUNT) tail.apply();
+		}
+
+		/// @brief Returns whether every channel's configuration makes sense.
+		bool consistent() const {
+			if constexpr (Tail::COUNT)
+				return head.consistent() && tail.consistent();
+			else return head.consistent();
+		}
+
+		/// @brief Returns whether every channel's record was intact.
+		bool valid() const {
+			if constexpr (Tail::COUNT)
+				return head.valid() && tail.valid();
+			else return head.valid();
+		}
+
+		/// @brief Takes a reading from every channel.
+		Reading sample() {
+			Reading r;
+			r.head = head.sample();
+			if constexpr (Tail::COUNT) r.tail = tail.sample();
+			return r;
+		}
+
+		/// @brief Returns whether every channel's reading holds actual measurements.
+		bool measured(Reading const& r) const {
+			if constexpr (Tail::COUNT)
+				return head.measured(r.head) && tail.measured(r.tail);
+			else return head.measured(r.head);
+		}
+
+		/// @brief Evaluates a set of readings.
+		/// @return Alarm pattern of the first channel out of its thresholds, or `BAP_OK`.
+		Alarm::Pattern check(Reading const& r) const {
+			auto const p = head.check(r.head);
+			if constexpr (Tail::COUNT)
+				if (p == Alarm::Pattern::BAP_OK)
+					return tail.check(r.tail);
+			return p;
+		}
+
+		/// @brief Returns a set of readings as a string.
+		String toString(Reading const& r) const {
+			if constexpr (Tail::COUNT)
+				return head.toString(r.head) + ", " + tail.toString(r.tail);
+			else return head.toString(r.head);
+		}
+
+		/// @brief Returns a set of readings' raw values, comma-separated.
+		String toValues(Reading const& r) const {
+			if constexpr (Tail::COUNT)
+				return head.toValues(r.head) + "," + tail.toValues(r.tail);
+			else return head.toValues(r.head);
+		}
+
+		/// @brief Shows a display page.
+		/// @param display Display to show page on.
+		/// @param r Readings to show.
+		/// @param page Page to show, out of `PAGES`.
+		void show(Display& display, Reading const& r, uint8 const page) const {
+			if (page < C::PAGES)
+				return head.show(display, r.head, page);
+			if constexpr (Tail::COUNT)
+				tail.show(display, r.tail, page - C::PAGES);
+		}
+
+		/// @brief Calls a function on every channel, in order.
+		/// @param f Function to call, as `f(channel, index)`.
+		template <class F>
+		void forEach(F&& f, uint8 const index = 0) {
+			f(head, index);
+			if constexpr (Tail::COUNT) tail.forEach(f, index + 1);
+		}
+
+		/// @brief Returns a channel of a given type.
+		/// @tparam T Channel type, or base type (e.g. `Sensor` matches every `BasicSensor`).
+		/// @param n Which of the channels of type `T` to get.
+		/// @return Pointer to channel, or `nullptr` if there is no such channel.
+		template <class T>
+		T* find(uint8 const n = 0) {
+			if constexpr (IsBaseOf<T, C>)
+				if (!n) return &head;
+			if constexpr (Tail::COUNT)
+				return tail.template find<T>(n - IsBaseOf<T, C>);
+			else return nullptr;
+		}
+
+	private:
+		/// @brief First channel.
+		C		head;
+		/// @brief Rest of the channels.
+		Tail	tail;
+	};
+}
+
+#endif
@@ -18,6 +18,9 @@ namespace Bits {
 			int8 timeZone: 7;
 		};
 
+		/// @brief Clock information record type.
+		using InfoRecord = Record<Info, CacheType::BCT_CACHE_WRITE_BACK>;
+
 		/// @brief Constructs the clock.
 		/// @param info EEPROM address of the clock's info.
 		Clock(eeprom_address const info):
@@ -29,6 +32,13 @@ namespace Bits {
 			info.begin();
 		}
 
+		/// @brief Commits pending changes to the clock's information, once they have settled.
+		void update()	{info.update();	}
+		/// @brief Commits pending changes to the clock's information immediately.
+		void save()		{info.save();	}
+		/// @brief Discards pending changes to the clock's information.
+		void revert()	{info.revert();	}
+
 		/// @brief Returns the current time as a UNIX timestamp.
 		/// @return Current time as UNIX timestamp.
 		uint32 unixNow() const {
@@ -49,7 +59,7 @@ namespace Bits {
 		
 		/// @brief Sets the current time zone.
 		/// @param timeZone Current time zone, in quarter-of-hours.
-		void setTimeZone(int8 const timeZone) const {
+		void setTimeZone(int8 const timeZone) {
 			Info i = info;
 			i.timeZone = timeZone;
 			info = i;
@@ -71,10 +81,13 @@ namespace Bits {
 			return info.get().adjusted;
 		}
 
+		/// @brief Returns whether the clock's stored information was intact when it was initialized.
+		bool valid() const		{return info.valid();				}
+
 		/// @brief Returns the clock's address in the EEPROM.
 		uint16 address() const	{return info.address();				}
 		/// @brief Returns one-past-the-end of the clock's address in the EEPROM.
-		uint16 end() const		{return address()	+ sizeof(Info);	}
+		uint16 end() const		{return address()	+ InfoRecord::SIZE;		}
 
 	private:
 		/// @brief Returns the time zone as an UNIX timestamp offset.
@@ -85,7 +98,7 @@ namespace Bits {
 		/// @brief Pin the external clock is located in.
 		uint8			pin;
 		/// @brief Clock information.
-		Record<Info>	info;
+		InfoRecord		info;
 		/// @brief Underlying Real-Time Clock.
 		RTC_DS1307		rtc;
 	};
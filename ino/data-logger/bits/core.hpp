@@ -1,6 +1,8 @@
 #ifndef BITS_CORE_H
 #define BITS_CORE_H
 
+#include <avr/wdt.h>
+
 #include "types.hpp"
 
 /// @brief Helper classes & functions.
@@ -23,12 +25,96 @@ namespace Bits {
 		inline void seconds(float const time)	{millis(time * 1000);	}
 	}
 
-	/// @brief Resets the arduino.
-	/// @warning Soft resets the adruino! Do not use this without knowing what you're doing!
+	/// @brief Serial baud rate helpers.
+	namespace Baud {
+		/// @brief Supported baud rates. The first one is the default (and fallback) rate.
+		constexpr uint32 const RATES[] = {
+			9600,
+			19200,
+			38400,
+			57600,
+			115200,
+			230400,
+			250000,
+			500000,
+			1000000
+		};
+
+		/// @brief Amount of supported baud rates.
+		constexpr uint8 const COUNT = sizeof(RATES) / sizeof(uint32);
+
+		/// @brief Returns the baud rate for a given index.
+		/// @param index Baud rate index.
+		/// @return Baud rate, or the default rate if index is invalid.
+		constexpr uint32 rate(uint8 const index) {
+			return index < COUNT ? RATES[index] : RATES[0];
+		}
+
+		/// @brief Returns the index of a given baud rate.
+		/// @param rate Baud rate to look for.
+		/// @return Index of the baud rate, or `COUNT` if it is not supported.
+		constexpr uint8 index(uint32 const rate) {
+			for (uint8 i = 0; i < COUNT; ++i)
+				if (RATES[i] == rate) return i;
+			return COUNT;
+		}
+
+		/// @brief Returns the time it takes to send a given amount of bytes (8N1 framing), rounded up.
+		/// @param bytes Amount of bytes.
+		/// @param rate Baud rate.
+		/// @return Transfer time, in milliseconds.
+		constexpr uint32 transferTime(uint16 const bytes, uint32 const rate) {
+			return (bytes * 10000ul + rate - 1) / rate;
+		}
+
+		static_assert(COUNT <= 16);
+		static_assert(rate(index(115200)) == 115200);
+		static_assert(index(1234) == COUNT);
+		static_assert(transferTime(96, 9600) == 100);
+		static_assert(transferTime(1, 115200) == 1);
+	}
+
+	namespace {
+		/// @brief MCU status register (reset cause flags), as it was at boot.
+		[[gnu::section(".noinit")]]
+		static uint8 bootStatus;
+
+		/// @brief Set right before an intentional reset. Survives the reset.
+		[[gnu::section(".noinit")]]
+		static uint8 resetRequest;
+
+		/// @brief Captures (and clears) the reset cause and disables the watchdog, before anything else runs.
+		[[gnu::naked, gnu::used, gnu::section(".init3")]]
+		static void captureResetCause() {
+			bootStatus = MCUSR;
+			MCUSR = 0;
+			wdt_disable();
+		}
+	}
+
+	/// @brief Value `resetRequest` holds after an intentional reset.
+	constexpr uint8 const RESET_REQUEST	= 0xA5;
+	/// @brief Value `resetRequest` holds after the reset that ends an EEPROM wipe.
+	constexpr uint8 const RESET_WIPE	= 0x5A;
+
+	/// @brief Returns the reset cause flags (`MCUSR`) captured at boot.
+	inline uint8 resetCause() {return bootStatus;}
+
+	/// @brief Returns whether the last reset was requested through `reset()`. Only valid until `begin()` of the watchdog.
+	inline bool resetRequested() {return resetRequest == RESET_REQUEST || resetRequest == RESET_WIPE;}
+
+	/// @brief Returns whether the last reset ended an EEPROM wipe. Only valid until `begin()` of the watchdog.
+	inline bool wipeRequested() {return resetRequest == RESET_WIPE;}
+
+	/// @brief Resets the arduino, through the watchdog. Resets all peripherals.
+	/// @warning Resets the adruino! Do not use this without knowing what you're doing!
+	/// @param request Value to leave in `resetRequest`, telling the next boot why it happened.
 	[[gnu::always_inline, noreturn]]
-	inline void reset() {
-		As<void(void)>* crash = nullptr;
-		crash();
+	inline void reset(uint8 const request = RESET_REQUEST) {
+		resetRequest = request;
+		cli();
+		wdt_enable(WDTO_15MS);
+		for (;;) {}
 	}
 }
 
@@ -0,0 +1,68 @@
+#ifndef BITS_CRC_H
+#define BITS_CRC_H
+
+#include "types.hpp"
+
+/// @brief Helper classes & functions.
+namespace Bits {
+	/// @brief Checksum functions.
+	namespace CRC {
+		/// @brief Updates a CRC-8 (Dallas/Maxim) checksum with a byte.
+		/// @param crc Current checksum.
+		/// @param data Byte to add.
+		/// @return Updated checksum.
+		constexpr uint8 update(uint8 crc, uint8 const data) {
+			crc ^= data;
+			for (uint8 i = 0; i < 8; ++i)
+				crc = (crc & 1) ? ((crc >> 1) ^ 0x8C) : (crc >> 1);
+			return crc;
+		}
+
+		/// @brief Computes the CRC-8 (Dallas/Maxim) checksum of a block of bytes.
+		/// @param data Bytes to compute checksum for.
+		/// @param size Byte count.
+		/// @param crc Initial checksum value.
+		/// @return Checksum.
+		constexpr uint8 crc8(uint8 const* const data, usize const size, uint8 crc = 0) {
+			for (usize i = 0; i < size; ++i)
+				crc = update(crc, data[i]);
+			return crc;
+		}
+
+		/// @brief Computes the CRC-8 (Dallas/Maxim) checksum of an object's bytes.
+		/// @tparam T Object type.
+		/// @param value Object to compute checksum for.
+		/// @param crc Initial checksum value.
+		/// @return Checksum.
+		template <class T>
+		inline uint8 of(T const& value, uint8 const crc = 0) {
+			return crc8(reinterpret_cast<uint8 const*>(&value), sizeof(T), crc);
+		}
+
+		/// @brief Computes the CRC-8 (Sensirion: polynomial `0x31`, initial value `0xFF`) checksum of a block of bytes.
+		/// @param data Bytes to compute checksum for.
+		/// @param size Byte count.
+		/// @return Checksum.
+		constexpr uint8 sensirion(uint8 const* const data, usize const size) {
+			uint8 crc = 0xFF;
+			for (usize i = 0; i < size; ++i) {
+				crc ^= data[i];
+				for (uint8 j = 0; j < 8; ++j)
+					crc = (crc & 0x80) ? ((crc << 1) ^ 0x31) : (crc << 1);
+			}
+			return crc;
+		}
+
+		static_assert([] {
+			uint8 const check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+			return crc8(check, sizeof(check));
+		}() == 0xA1);
+
+		static_assert([] {
+			uint8 const check[] = {0xBE, 0xEF};
+			return sensirion(check, sizeof(check));
+		}() == 0x92);
+	}
+}
+
+#endif
\ No newline at end of file
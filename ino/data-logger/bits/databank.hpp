@@ -4,6 +4,7 @@
 #include <EEPROM.h>
 
 #include "types.hpp"
+#include "record.hpp"
 
 /// @brief EEPROM size.
 constexpr uint16 const EEPROM_SIZE = 1024;
@@ -11,21 +12,32 @@ constexpr uint16 const EEPROM_SIZE = 1024;
 /// @brief Helper classes & functions.
 namespace Bits {
 	/// @brief EEPROM data bank.
+	/// @details Entries are kept in a ring of slots, with one spare slot. New entries are always written into a free slot first,
+	/// and only become part of the bank once the header is committed. The header itself is kept in a power-fail-safe `RecordStorage`,
+	/// so an interrupted write never leaves the bank pointing at a half-written entry.
 	/// @tparam T Entry type.
 	/// @tparam MAX Possible entry limit.
 	template <class T, uint16 MAX = 64>
 	struct DataBank {
 		/// @brief Entry type.
 		using EntryType = T;
+		/// @brief Entry index type. Wide enough to address every slot the EEPROM can hold.
+		using IndexType = uint16;
 
 		/// @brief Data bank header.
-		struct [[gnu::align(1)]] Header {
+		struct PACKED Header {
 			uint32	exists		: 1;
 			uint32	entryStart	: 12;
 			uint32	entryCount	: 21;
+			/// @brief Slot holding the first entry.
+			uint16	entryHead;
+			/// @brief Size of the bank's entries.
+			uint8	entrySize;
 
 			/// @brief Maximum accessible amount of entries.
 			constexpr static uint32 const MAX_ENTRIES = (2ull << 19ull);
+			/// @brief Current header schema version. Also bumped whenever the meaning of stored entries changes.
+			constexpr static uint8 const VERSION = 4;
 
 			static_assert(MAX_ENTRIES > 0);
 			
@@ -33,16 +45,21 @@ namespace Bits {
 			constexpr static Header fromLocation(eeprom_address const location) {
 				return {
 					true,
-					location + sizeof(Header),
-					0
+					static_cast<uint32>(location + HeaderStorage::SIZE),
+					0,
+					0,
+					ENTRY_SIZE
 				};
 			}
 		};
 
+		/// @brief Header storage type.
+		using HeaderStorage = RecordStorage<Header, Header::VERSION>;
+
 		/// @brief Entry size.
 		constexpr static usize const	ENTRY_SIZE		= sizeof(EntryType);
 		/// @brief Header size.
-		constexpr static usize const	HEADER_SIZE		= sizeof(Header);
+		constexpr static usize const	HEADER_SIZE		= HeaderStorage::SIZE;
 
 		/// @brief Logical maximum amount of entries.
 		constexpr static uint32 const	MAX_SIZE		= MAX;
@@ -51,7 +68,18 @@ namespace Bits {
 		/// @brief True maximum amount of entries.
 		constexpr static uint32 const	MAX_ENTRIES		= (EEPROM_SIZE - HEADER_SIZE) / ENTRY_SIZE;
 
-		static_assert(MAX_ENTRIES	> 0);
+		/// @brief Total EEPROM footprint of the bank, including its spare slot.
+		constexpr static uint32 const	SIZE			= HEADER_SIZE + (MAX_CAPACITY + 1) * ENTRY_SIZE;
+
+		/// @brief Returns the maximum amount of entries a bank can hold within a given amount of bytes.
+		/// @param bytes Bytes available to the bank.
+		/// @return Entry capacity.
+		constexpr static uint16 capacityFor(usize const bytes) {
+			return (bytes - HEADER_SIZE) / ENTRY_SIZE - 1;
+		}
+
+		static_assert(MAX_ENTRIES	> 1);
+		static_assert(MAX_ENTRIES	<= static_cast<IndexType>(-1));
 		static_assert(MAX_CAPACITY	> 0);
 		static_assert(ENTRY_SIZE	> 0);
 
@@ -59,12 +87,27 @@ namespace Bits {
 		/// @param location Memory location the data bank is stored in. By default, it is the beginning of the EEPROM (`0`).
 		DataBank(eeprom_address const location = 0):
 			headerLocation(location),
-			header(Header::fromLocation(location)) {}
+			slotCount(slotsFor(location)),
+			header(Header::fromLocation(location)),
+			headerStorage(location) {}
 		
 		/// @brief initializes the data bank.
+		/// @note Recovers the last committed header. If no intact header is found, the bank is reset.
 		void begin() {
-			if (EEPROM.read(headerLocation))
-				EEPROM.get(headerLocation, header);
+			Header stored;
+			intact = (
+				headerStorage.load(stored)
+			&&	stored.exists
+			&&	stored.entrySize == ENTRY_SIZE
+			&&	stored.entryHead < slotCount
+			&&	stored.entryCount <= capacity()
+			);
+			if (intact)
+				header = stored;
+			else {
+				header = Header::fromLocation(headerLocation);
+				updateHeader();
+			}
 		}
 
 		/// @brief Constructs the data bank from a header and a memory location.
@@ -72,19 +115,112 @@ namespace Bits {
 		/// @param location Memory location the data bank is stored in.
 		DataBank(Header const& header, eeprom_address const location):
 			headerLocation(location),
-			header(header) {
+			slotCount(slotsFor(location)),
+			header(header),
+			headerStorage(location) {
 			updateHeader();
 		}
 
+		/// @brief Resumable, bidirectional entry cursor.
+		/// @details Entries are prefetched into a small RAM window, one block of consecutive slots at a time, in the direction of travel.
+		/// A cursor can be kept around between loop iterations, and picks up where it left off. If the bank changes meanwhile,
+		/// the window is fetched again.
+		/// @note Positions are logical indices. Once the bank is full, recording a new entry shifts every index down by one.
+		/// @tparam WINDOW Amount of entries to prefetch at once.
+		template <uint8 WINDOW = 4>
+		struct BasicCursor {
+			static_assert(WINDOW > 0);
+
+			/// @brief Constructs a cursor.
+			/// @param bank Bank to iterate through.
+			/// @param index Index to start at.
+			BasicCursor(DataBank const& bank, IndexType const index = 0):
+				bank(&bank), position(index) {}
+
+			/// @brief Returns whether the cursor points at an entry. Stepping back past the first entry also invalidates the cursor.
+			bool valid() const			{return position < bank->size();	}
+			/// @brief Returns the index the cursor points at.
+			IndexType index() const		{return position;					}
+
+			/// @brief Returns the entry the cursor points at.
+			/// @warning Only meaningful while `valid()`.
+			EntryType const& get() {
+				if (!cached()) prefetch();
+				return window[position - first];
+			}
+
+			/// @brief Dereference operator overloading.
+			EntryType const& operator*() {return get();}
+
+			/// @brief Moves to the next entry.
+			BasicCursor& operator++() {
+				++position;
+				forward = true;
+				return *this;
+			}
+
+			/// @brief Moves to the previous entry.
+			BasicCursor& operator--() {
+				--position;
+				forward = false;
+				return *this;
+			}
+
+			/// @brief Moves to a given entry.
+			/// @param index Entry index.
+			void seek(IndexType const index) {
+				position = index;
+			}
+
+		private:
+			/// @brief Returns whether the current entry is in the window, and the window is up to date.
+			bool cached() const {
+				return (
+					count
+				&&	revision == bank->revision()
+				&&	static_cast<IndexType>(position - first) < count
+				);
+			}
+
+			/// @brief Fills the window, starting (or ending) at the current entry.
+			void prefetch() {
+				if (forward)					first = position;
+				else if (position + 1 < WINDOW)	first = 0;
+				else							first = position + 1 - WINDOW;
+				IndexType const size = bank->size();
+				count = (first < size) ? ((size - first < WINDOW) ? size - first : WINDOW) : 0;
+				bank->fetch(first, window, count);
+				revision = bank->revision();
+			}
+
+			/// @brief Bank to iterate through.
+			DataBank const*	bank;
+			/// @brief Current entry.
+			IndexType		position;
+			/// @brief First entry in the window.
+			IndexType		first		= 0;
+			/// @brief Amount of entries in the window.
+			uint8			count		= 0;
+			/// @brief Bank revision the window was fetched at.
+			uint8			revision	= 0;
+			/// @brief Direction of travel.
+			bool			forward		= true;
+			/// @brief Prefetched entries.
+			EntryType		window[WINDOW];
+		};
+
+		/// @brief Default entry cursor type.
+		using Cursor = BasicCursor<>;
+
 		/// @brief Indexing operator overloading.
-		EntryType operator[](uint8 const index) const {
+		EntryType operator[](IndexType const index) const {
 			return get(index);
 		}
 
 		/// @brief Returns an entry at a given index.
 		/// @param index Entry index.
 		/// @return Entry at given location.
-		EntryType get(uint8 const index) const {
+		EntryType get(IndexType const index) const {
 			EntryType e;
 			fetch(index, e);
 			return e;
@@ -93,26 +229,43 @@ namespace Bits {
 		/// @brief Fetches an entry at a given index.
 		/// @param index Entry index.
 		/// @param output Where to store the fetched entry.
-		void fetch(uint8 const index, EntryType& output) const {
+		void fetch(IndexType const index, EntryType& output) const {
 			if (index < size())
-				EEPROM.get((header.entryStart + index * ENTRY_SIZE), output);
+				EEPROM.get(entryAddress(index), output);
+		}
+
+		/// @brief Fetches a block of consecutive entries.
+		/// @param index Index of the first entry.
+		/// @param output Where to store the fetched entries.
+		/// @param count Amount of entries to fetch. Stops early at the end of the bank.
+		void fetch(IndexType const index, EntryType* const output, IndexType const count) const {
+			if (index >= size()) return;
+			uint16 slot = (header.entryHead + index) % slotCount;
+			IndexType const end = (size() - index < count) ? size() - index : count;
+			for (IndexType i = 0; i < end; ++i) {
+				EEPROM.get(header.entryStart + slot * ENTRY_SIZE, output[i]);
+				slot = nextSlot(slot);
+			}
 		}
 
 		/// @brief Modifies an entry at a given index.
 		/// @param index Entry index.
-		/// @param entry Value to modify entry with.			
-		void set(uint8 const index, EntryType const& entry) {
-			if (index < size())
-				EEPROM.put((header.entryStart + index * ENTRY_SIZE), entry);
+		/// @param entry Value to modify entry with.
+		/// @warning Entries are modified in place. Unlike adding or removing entries, this is not power-fail-safe.
+		void set(IndexType const index, EntryType const& entry) {
+			if (index < size()) {
+				EEPROM.put(entryAddress(index), entry);
+				++changes;
+			}
 		}
 
 		/// @brief Adds an entry to the end of the bank.
 		/// @param entry Entry to add.
 		void push(EntryType const& entry) {
-			if (size() < MAX_ENTRIES && size() < MAX_CAPACITY) {
+			if (size() < capacity()) {
+				EEPROM.put(entryAddress(size()), entry);
 				++header.entryCount;
-				set(size() - 1, entry);
-				updateHeader();
+				updateHeader(false);
 			}
 		}
 
@@ -136,17 +289,13 @@ namespace Bits {
 			return e;
 		}
 
-		/// @brief Shifts all the entries of the bank one entry back.
-		void fastShiftDown() {
+		/// @brief Shifts all the entries of the bank back, dropping the first ones.
+		/// @param count Amount of entries to drop.
+		void fastShiftDown(IndexType const count = 1) {
 			if (empty()) return;
-			auto sz = header.entryCount-1;
-			EntryType e;
-			while (sz > 0) {
-				fetch(sz, e);
-				set(sz-1, e);
-				--sz;
-			}
-			--header.entryCount;
+			IndexType const n = (count < size()) ? count : size();
+			header.entryHead = (header.entryHead + n) % slotCount;
+			header.entryCount -= n;
 			updateHeader();
 		}
 
@@ -162,37 +311,104 @@ namespace Bits {
 		
 		/// @brief Empties the bank.
 		void clear() {
-			header.entryCount = 0;
+			header.entryCount	= 0;
+			header.entryHead	= 0;
 			updateHeader();
 		}
 
 		/// @brief Records an entry in the entry bank. If the bank is full, removes the first entry in the bank.
 		/// @param entry Entry to record.
 		void record(EntryType const& entry) {
-			if (size() >= MAX_ENTRIES)
-				fastShiftDown();
-			push(entry);
+			if (size() < capacity())
+				return push(entry);
+			EEPROM.put(entryAddress(size()), entry);
+			header.entryHead = nextSlot(header.entryHead);
+			updateHeader();
+		}
+
+		/// @brief Returns the EEPROM address the next recorded entry goes to. Always a free slot.
+		eeprom_address recordAddress() const {
+			return entryAddress(size());
+		}
+
+		/// @brief Records an entry already written at `recordAddress()`, like `record()` does, but leaves committing the header to the caller.
+		/// @return Header slot to write at `headerAddress()`.
+		/// @note Until the header slot is fully written, the bank is only updated in RAM. An interrupted write loses the entry, nothing else.
+		typename HeaderStorage::Slot recordWritten() {
+			if (size() < capacity())
+				++header.entryCount;
+			else {
+				header.entryHead = nextSlot(header.entryHead);
+				++changes;
+			}
+			return headerStorage.prepare(header);
+		}
+
+		/// @brief Returns the EEPROM address of the current header slot.
+		eeprom_address headerAddress() const {
+			return headerStorage.valueAddress();
 		}
 
 		/// @brief Returns the EEPROM address of the bank.
 		/// @return Location of bank.		
-		inline eeprom_address	address() const	{return headerLocation;		}
+		inline eeprom_address	address() const		{return headerLocation;		}
 		/// @brief Returns the amount of entries in the bank.
 		/// @return Entry count.
-		inline uint32			size() const	{return header.entryCount;	}
+		inline uint32			size() const		{return header.entryCount;	}
+		/// @brief Returns the maximum amount of entries the bank can hold.
+		/// @return Entry capacity.
+		inline uint32			capacity() const	{return slotCount - 1;		}
 		/// @brief Returns whether the bank is empty.
 		/// @return Whether bank is empty.
-		inline bool				empty() const	{return size() == 0;		}
+		inline bool				empty() const		{return size() == 0;		}
+		/// @brief Returns whether the stored header was intact when the bank was initialized.
+		/// @return Whether bank was intact.
+		inline bool				valid() const		{return intact;				}
+		/// @brief Returns a counter that changes whenever existing entries are changed, moved or removed. Appending entries leaves it be.
+		/// @return Bank revision.
+		inline uint8			revision() const	{return changes;			}
 
 	private:
+		/// @brief Returns the amount of entry slots available for a bank at a given location, including the spare slot.
+		/// @param location Memory location of the bank.
+		constexpr static uint16 slotsFor(eeprom_address const location) {
+			return (
+				((EEPROM_SIZE - location - HEADER_SIZE) / ENTRY_SIZE < MAX_CAPACITY + 1)
+			?	(EEPROM_SIZE - location - HEADER_SIZE) / ENTRY_SIZE
+			:	MAX_CAPACITY + 1
+			);
+		}
+
+		/// @brief Returns the slot following a given slot.
+		/// @param slot Slot to get the next one of.
+		inline uint16 nextSlot(uint16 const slot) const {
+			return (slot + 1 < slotCount) ? slot + 1 : 0;
+		}
+
+		/// @brief Returns the EEPROM address of an entry.
+		/// @param index Entry index.
+		inline eeprom_address entryAddress(uint32 const index) const {
+			return header.entryStart + ((header.entryHead + index) % slotCount) * ENTRY_SIZE;
+		}
+
 		/// @brief Header location.
 		eeprom_address headerLocation = 0;
+		/// @brief Amount of entry slots, including the spare slot.
+		uint16 const slotCount;
 		/// @brief Bank header.	
 		Header header = Header::fromLocation(headerLocation);
+		/// @brief Header storage.
+		HeaderStorage headerStorage;
+		/// @brief Whether the stored header was intact.
+		bool intact = true;
+		/// @brief Bank revision.
+		uint8 changes = 0;
 
-		/// @brief Updates the header in the EEPROM.
-		void updateHeader() {
-			EEPROM.put(headerLocation, header);
+		/// @brief Commits the header to the EEPROM.
+		/// @param reshaped Whether existing entries were changed, moved or removed, rather than just appended to.
+		void updateHeader(bool const reshaped = true) {
+			headerStorage.store(header);
+			if (reshaped) ++changes;
 		}
 	};
 }
@@ -9,8 +9,19 @@
 #include "display.hpp"
 #include "parser.hpp"
 #include "core.hpp"
-#include "pitch.hpp"
 #include "logo.hpp"
+#include "units.hpp"
+#include "layout.hpp"
+#include "power.hpp"
+#include "alarm.hpp"
+#include "watchdog.hpp"
+#include "channels.hpp"
+#include "filter.hpp"
+#include "output.hpp"
+#include "retention.hpp"
+#include "wipe.hpp"
+#include "staging.hpp"
+#include "memory.hpp"
 
 /// @brief Helper classes & functions.
 namespace Bits {
@@ -21,6 +32,8 @@ namespace Bits {
 			BDLLD_CONFIG_ERROR,
 			BDLLD_OK,
 			BDLLD_EMERGENCY,
+			/// @brief No reading yet. All lights off.
+			BDLLD_WAITING,
 		};
 
 		/// @brief Data logger information.
@@ -35,6 +48,16 @@ namespace Bits {
 			byte luminosityOK:	1;
 			/// @brief Whether the LDR was calibrated correctly.
 			byte calibrationOK:	1;
+			/// @brief Serial baud rate, as an index into `Baud::RATES`.
+			byte baudRate:		4;
+			/// @brief Whether to use deep (power-down) sleep while idle.
+			byte deepSleep:		1;
+			/// @brief Whether to skip the boot logo animation.
+			byte skipLogo:		1;
+			/// @brief Whether any stored configuration was corrupted or outdated, and restored to its defaults at boot.
+			byte restored:		1;
+			/// @brief Whether to answer commands with compact `code[,payload]` lines, instead of prose.
+			byte machineMode:	1;
 
 			/// @brief Returns whether everything was configured correctly.
 			constexpr bool ok() {
@@ -48,165 +71,698 @@ namespace Bits {
 			}
 		};
 
+		/// @brief Data logger information record type.
+		using InfoRecord = Record<Info, CacheType::BCT_CACHE_WRITE_BACK>;
+
+		/// @brief Sensor channels. Adding a probe is a matter of adding its type here, and its pin to the constructor.
+		/// @note Temperature & humidity sensors take a backend: `BasicSensor<DHT22Backend>`, `BasicSensor<SHT3xBackend<>>`...
+		/// Any channel can be wrapped in `Filtered<Channel, Filter<...>>` to smooth out its readings.
+		using ChannelsType = Channels<
+			Filtered<BasicSensor<DHT11Backend>,	Filter<Filters::Reject<1000>, Filters::Median<3>>>,
+			Filtered<LDR,						Filter<Filters::Median<3>>>
+		>;
+
 		/// @brief Data logger log.
 		struct PACKED Log {
 			/// @brief UNIX timestamp of the log's date.
-			uint32			timestamp;
-			/// @brief Temperature & humidity values.
-			Sensor::Value	value;
-			/// @brief Luminosity.
-			int16			luminosity;
+			uint32					timestamp;
+			/// @brief Reading of every channel.
+			ChannelsType::Reading	value;
+			/// @brief Whether this is a sample, or part of a summary of older logs.
+			LogTag					tag;
 
 			/// @brief Returns the log as a string.
-			/// @param sensor Sensor to get current display unit from.
+			/// @param channels Channels to get current display units from.
 			/// @return Log as string
-			String toString(Sensor& sensor) const {
+			String toString(ChannelsType const& channels) const {
 				String log = "[";
-				log += DateTime(timestamp).timestamp() + "]: { ";
-				auto const v = sensor.toCurrentUnit(value);
-				log += "Temperature: [" + String(v.temperature / 100.0) + static_cast<char>(sensor.getUnit()) + "], ";
-				log += "Humidity: [" + String(v.humidity / 100.0) + "%], ";
-				log += "Luminosity: [" + String(luminosity) + "%] };";
+				log += DateTime(timestamp).timestamp() + "]";
+				if (tag.tier) {
+					switch (static_cast<Statistic>(tag.stat)) {
+						case Statistic::BST_MIN:	log += " (min";		break;
+						case Statistic::BST_MAX:	log += " (max";		break;
+						default:					log += " (mean";	break;
+					}
+					log += ", tier " + String(tag.tier) + ")";
+				}
+				log += ": { ";
+				log += channels.toString(value);
+				log += " };";
 				return log;
 			}
 		};
 
+		/// @brief EEPROM layout of the configuration records.
+		using ConfigLayout = Layout<
+			0,
+			InfoRecord,
+			Clock::InfoRecord,
+			ChannelsType,
+			Watchdog::BreadcrumbRecord
+		>;
+
+		/// @brief Data bank type. Takes up all the EEPROM left after the configuration records.
+		using DataBankType = DataBank<Log, DataBank<Log>::capacityFor(ConfigLayout::FREE)>;
+
+		/// @brief Full EEPROM layout.
+		using EEPROMLayout = Layout<ConfigLayout::END, DataBankType>;
+
+		/// @brief Log retention engine type. Merges the oldest logs 8 at a time, once only 2 free slots are left.
+		using RetentionType = Retention<DataBankType, 8, 2>;
+
 		/// @brief Serial interface parser type.
-		using ParserType = Parser<Log>;
+		using ParserType = Parser<Log, DataBankType::MAX_SIZE, ChannelsType>;
 
 		/// @brief LED indicator pins.
 		struct LEDPins {
 			avr_pin red, yellow, green;
 		};
 
+		/// @brief Channel pins, in channel order.
+		struct ChannelPins {
+			avr_pin pins[ChannelsType::COUNT];
+		};
+
 		/// @brief Constructs the data logger.
-		/// @param sensorPin Temperature & humidity sensor pin.
-		/// @param ldrPin LDR pin.
+		/// @param channelPins Channel pins (temperature & humidity sensor, then LDR).
 		/// @param ledPins LED pins.
-		/// @param alarmPin Alarm pin.	
+		/// @param alarmPin Alarm (buzzer) pin.	
 		DataLogger(
-			avr_pin const	sensorPin	= 2,
-			avr_pin const	ldrPin		= A0,
-			LEDPins const&	ledPins		= {3, 4, 5},
-			avr_pin const	alarmPin	= 6
+			ChannelPins const&	channelPins	= {{2, A0}},
+			LEDPins const&		ledPins		= {3, 4, 5},
+			avr_pin const		alarmPin	= 6
 		):
-			info(0),
-			clock(16),
-			sensor(sensorPin, 32),
-			ldr(ldrPin, 48),
-			db(64),
+			info(ConfigLayout::address<0>()),
+			clock(ConfigLayout::address<1>()),
+			channels(ConfigLayout::address<2>(), channelPins.pins),
+			db(EEPROMLayout::address<0>()),
+			retention(db),
+			staging(db),
 			display(),
+			logo(display),
+			watchdog(ConfigLayout::address<3>()),
+			power(watchdog),
+			cursor(db),
 			led(ledPins),
 			alarm(alarmPin) {}
 
 		/// @brief Initializes the data logger.
 		void begin() {
-			Logo logo{display};
-			Serial.begin(9600);
+			Serial.begin(Baud::RATES[0]);
 			EEPROM.begin();
-			sensor.begin();
+			channels.begin();
 			clock.begin();
-			ldr.begin();
 			display.begin();
 			db.begin();
+			staging.begin();
 			info.begin();
 			logo.begin();
+			// A wipe leaves nothing intact on purpose. That is not corruption.
+			bool const wiped = wipeRequested();
+			watchdog.begin();
+			power.begin();
+			checkRecords(wiped);
 			if (!clock.adjusted())
 				clock.adjust({F(__DATE__), F(__TIME__)});
 			pinMode(led.red,	OUTPUT);
 			pinMode(led.yellow,	OUTPUT);
 			pinMode(led.green,	OUTPUT);
 			pinMode(led.green,	OUTPUT);
-			pinMode(alarm,		OUTPUT);
-			display.setDisplay(Display::State::BDS_OFF);
-			Wait::seconds(1);
-			display.setDisplay(Display::State::BDS_ON);
-			logo.animate();
-			Serial.println("Command-line ready.");
+			alarm.begin();
+			value		= channels.sample();
+			lastSample	= millis();
+			if (info.get().skipLogo)
+				display.setDisplay(Display::State::BDS_ON);
+			else logo.animate();
+			beginSerial();
+			if (!fallback) printReady();
 		}
 
 		/// @brief Updates the data logger.
 		void update() {
-			if (Serial.available()) {
+			watchdog.kick();
+			watchdog.enter(Watchdog::Stage::BWS_COMMAND);
+			if (fallback)
+				awaitFallback();
+			else if (wipe.busy() || wipe.done())
+				continueWipe();
+			else if (listing)
+				printListing();
+			else if (Serial.available()) {
+				power.stayAwake();
 				auto str = Serial.readStringUntil('\n');
 				str.toLowerCase();
-				ParserType parser{db, clock, sensor, ldr};
+				ParserType parser{db, clock, channels, watchdog, transaction, out};
 				auto const result = parser.evaluate(str);
-				switch (result.type) {
-					case ParserType::Response::Type::BPRT_OK: {
-						Serial.println("Operation completed successfully.");
-						auto i = info.get();
-						switch (result.id & 0xF) {
-							case static_cast<decltype(result.id)>(-1): Serial.println("Resetting..."); reset();
-							case 1: i.clockOK = true;		break;
-							case 2: i.temperatureOK = true; break;
-							case 3: i.humidityOK = true;	break;
-							case 4: i.luminosityOK = true;	break;
-							case 5: i.calibrationOK = true;	break;
-							case 6: {
-								Serial.println(
-									Log{
-										clock.unixNow(),
-										sensor.readRaw(),
-										ldr.read()
-									}.toString(sensor)
-								);
-							} break;
-							case 7: {
-								Serial.print("LDR: ");
-								Serial.println(ldr.readRaw());
-							}
-							default: break;
+				bool const machine = info.get().machineMode;
+				String payload;
+				if (result.type == ParserType::Response::Type::BPRT_OK) {
+					using Action = ParserType::Response::Action;
+					if (transaction.active) {
+						if (result.configures()) ++transaction.changes;
+					} else if (!machine && result.action != Action::BPRA_VIEW_LOG) printMessage(result.type);
+					auto i = info.get();
+					switch (result.action) {
+						case Action::BPRA_RESET: {
+							if (!machine) out.println(F("Resetting..."));
+							out.drain();
+							if (transaction.active) revertRecords();
+							saveRecords();
+							staging.flush();
+							reset();
 						}
-						info = i;
-					} break;
-					case ParserType::Response::Type::BPRT_NOT_A_COMMAND:	{Serial.println("Not a command string. Commands start with '@'.");									} break;
-					case ParserType::Response::Type::BPRT_MISSING_COMMAND: 	{																									} break;
-					case ParserType::Response::Type::BPRT_INVALID_COMMAND:	{Serial.println("Unknown/Invalid/Unsupported command. Did you perhaps misspell it?");				} break;
-					case ParserType::Response::Type::BPRT_MISSING_ARGUMENT:	{Serial.println("Missing necessary argument(s) for command.");										} break;
-					case ParserType::Response::Type::BPRT_INVALID_ARGUMENT:	{Serial.println("Unknown/Invalid/Unsupported argument(s). Did you perhaps misspell one or more?");	} break;
-					case ParserType::Response::Type::BPRT_MISSING_VALUE:	{Serial.println("Missing necessary value(s) for command.");											} break;
-					case ParserType::Response::Type::BPRT_INVALID_VALUE:	{Serial.println("Invalid value(s) for argument. Did you perhaps mistype/misarrange them?");			} break;
-					default: Serial.println("Unknown error. Sorry :/"); break;
+						case Action::BPRA_CLOCK_SET:		i.clockOK = true;		break;
+						case Action::BPRA_TEMPERATURE_SET:	i.temperatureOK = true;	break;
+						case Action::BPRA_HUMIDITY_SET:		i.humidityOK = true;	break;
+						case Action::BPRA_LUMINOSITY_SET:	i.luminosityOK = true;	break;
+						case Action::BPRA_CALIBRATION_SET:	i.calibrationOK = true;	break;
+						case Action::BPRA_READ_SENSORS: {
+							Log const log{clock.unixNow(), value};
+							if (machine)
+								payload = String(log.timestamp) + "," + channels.toValues(log.value);
+							else out.println(log.toString(channels));
+						} break;
+						case Action::BPRA_RAW_LDR: {
+							if (machine) payload = String(result.value);
+							else {
+								out.print(F("LDR: "));
+								out.println(result.value);
+							}
+						} break;
+						case Action::BPRA_BAUD: {
+							i.baudRate = result.value;
+							if (machine) payload = String(Baud::rate(i.baudRate));
+							else {
+								out.print(F("Switching to "));
+								out.print(Baud::rate(i.baudRate));
+								out.println(F(" baud."));
+							}
+							changeBaud = true;
+						} break;
+						case Action::BPRA_SLEEP:			i.deepSleep = result.value;		break;
+						case Action::BPRA_ALARM_ACK:		alarm.acknowledge();			break;
+						case Action::BPRA_ALARM_SILENCE:	alarm.silence(result.value);	break;
+						case Action::BPRA_LOGO:				i.skipLogo = result.value;		break;
+						case Action::BPRA_BEGIN:			beginTransaction(machine);		break;
+						case Action::BPRA_COMMIT: {
+							if (machine) payload = String(transaction.changes);
+							commitTransaction(machine);
+						} break;
+						case Action::BPRA_ABORT: {
+							if (machine) payload = String(transaction.changes);
+							abortTransaction(machine);
+							i = info.get();
+						} break;
+						case Action::BPRA_MODE:				i.machineMode = result.value;	break;
+						case Action::BPRA_VIEW_LOG: {
+							listing = true;
+							cursor.seek(0);
+						} break;
+						case Action::BPRA_STREAM: {
+							startStream(result.value & 0xFFFF, result.value >> 16);
+							if (machine) payload = String(stream.period);
+							else if (stream.period) {
+								out.print(F("Streaming every "));
+								out.print(stream.period);
+								out.println(F(" ms. Send '@stream off' to stop."));
+							}
+						} break;
+						case Action::BPRA_WIPE: {
+							wipe.start();
+							wipeReport = 0;
+							if (!machine) out.println(F("Wiping the EEPROM..."));
+						} break;
+						case Action::BPRA_WIPE_LOG: {
+							staging.clear();
+							db.clear();
+						} break;
+						case Action::BPRA_STATS_MEMORY: {
+							if (machine) payload = memoryValues();
+							else printMemory();
+						} break;
+						default: break;
+					}
+					info = i;
+					// Staged thresholds only drive the alarm once committed.
+					if (!transaction.active) channels.apply();
+				} else if (!machine) printMessage(result.type);
+				if (!listing && !wipe.busy())
+					finishCommand(result.type, payload);
+			}
+			out.pump();
+			watchdog.enter(Watchdog::Stage::BWS_RECORDS);
+			if (!transaction.active && !wipe.busy())
+				updateRecords();
+			// The staging queue owns the bank's header until it drains.
+			if (!listing && !wipe.busy() && staging.empty())
+				retention.update();
+			watchdog.enter(Watchdog::Stage::BWS_ANIMATION);
+			bool const animating = logo.update();
+			alarm.update();
+			watchdog.enter(Watchdog::Stage::BWS_SENSING);
+			if (millis() - lastSample >= SAMPLE_INTERVAL) {
+				lastSample = millis();
+				value = channels.sample();
+			}
+			if (millis() - lastTick >= TICK_INTERVAL) {
+				lastTick = millis();
+				tick();
+			}
+			if (stream.period && millis() - stream.last >= stream.period) {
+				stream.last += stream.period;
+				// Resync after a gap, rather than bursting to catch up.
+				if (millis() - stream.last >= stream.period)
+					stream.last = millis();
+				streamSample();
+			}
+			Memory::track();
+			watchdog.enter(Watchdog::Stage::BWS_SLEEP);
+			if (!wipe.busy())
+				staging.resume();
+			if (!out.empty() || wipe.busy() || retention.busy())
+				power.nap();
+			else {
+				uint32 deadline = lastTick + TICK_INTERVAL;
+				if (static_cast<int32>(lastSample + SAMPLE_INTERVAL - deadline) < 0)
+					deadline = lastSample + SAMPLE_INTERVAL;
+				if (stream.period && static_cast<int32>(stream.last + stream.period - deadline) < 0)
+					deadline = stream.last + stream.period;
+				if (alarm.waiting() && static_cast<int32>(alarm.deadline() - deadline) < 0)
+					deadline = alarm.deadline();
+				if (fallback && static_cast<int32>(fallbackStart + BAUD_FALLBACK_WINDOW - deadline) < 0)
+					deadline = fallbackStart + BAUD_FALLBACK_WINDOW;
+				power.sleepUntil(
+					(animating && static_cast<int32>(logo.deadline() - deadline) < 0) ? logo.deadline() : deadline,
+					(info.get().deepSleep && staging.empty() && !stream.period && !fallback) ? Power::Mode::BPM_DEEP : Power::Mode::BPM_IDLE
+				);
+			}
+			staging.pause();
+		}
+
+	private:
+		/// @brief Time, in milliseconds, between sensor checks and display updates.
+		constexpr static uint16 const TICK_INTERVAL = 1000;
+
+		/// @brief Time, in milliseconds, between channel samples. As fast as the slowest channel allows.
+		constexpr static uint16 const SAMPLE_INTERVAL = ChannelsType::INTERVAL;
+
+		/// @brief Free output queue space, in bytes, needed to print the next log entry.
+		constexpr static uint16 const LISTING_ROOM = 96;
+
+		/// @brief Prints the next log entries, as many as fit in the output queue without waiting.
+		/// @details Once every entry is printed, closes the listing and finishes the `@view log` command.
+		void printListing() {
+			ParserType const parser{db, clock, channels, watchdog, transaction, out};
+			while (out.empty() || out.room() >= LISTING_ROOM) {
+				if (cursor.valid()) {
+					parser.printLogEntry(*cursor);
+					++cursor;
+					continue;
+				}
+				parser.printLogFooter();
+				listing = false;
+				bool const machine = info.get().machineMode;
+				if (!machine && !transaction.active)
+					printMessage(ParserType::Response::Type::BPRT_OK);
+				finishCommand(ParserType::Response::Type::BPRT_OK);
+				return;
+			}
+		}
+
+		/// @brief Telemetry stream state.
+		struct Stream {
+			/// @brief Time between samples, in milliseconds. `0` while not streaming.
+			uint16	period		= 0;
+			/// @brief Time between samples asked for, in milliseconds, before the baud rate limit.
+			uint16	requested	= 0;
+			/// @brief Fields to stream, as a bit mask of `int16` fields of a reading.
+			uint16	mask		= 0;
+			/// @brief Time of the last sample.
+			uint32	last		= 0;
+			/// @brief Sample sequence number. Also counts samples dropped for lack of bandwidth.
+			uint8	sequence	= 0;
+		};
+
+		/// @brief Amount of `int16` fields in a reading.
+		constexpr static uint8 const FIELDS = sizeof(ChannelsType::Reading) / sizeof(int16);
+
+		/// @brief Starts (or stops) streaming the latest readings.
+		/// @details The period is stretched to whatever the baud rate can keep up with.
+		/// @param period Time between samples, in milliseconds. `0` to stop.
+		/// @param mask Fields to stream.
+		void startStream(uint16 const period, uint16 const mask) {
+			stream = {};
+			if (!period) return;
+			stream.mask			= mask;
+			stream.requested	= period;
+			stream.last			= millis();
+			paceStream(Baud::rate(info.get().baudRate));
+		}
+
+		/// @brief Stretches the stream period to whatever a baud rate can keep up with.
+		/// @param rate Baud rate.
+		void paceStream(uint32 const rate) {
+			if (!stream.requested) return;
+			uint32 const limit = Baud::transferTime(streamLineSize(), rate);
+			stream.period = (stream.requested < limit) ? limit : stream.requested;
+		}
+
+		/// @brief Returns the size of a stream line, in bytes.
+		uint8 streamLineSize() const {
+			uint8 fields = 0;
+			for (uint8 i = 0; i < FIELDS; ++i)
+				if (stream.mask & (1u << i)) ++fields;
+			return 1 + 2 + 4 * fields + 2;
+		}
+
+		/// @brief Streams the latest readings, as `>` and the sequence number, then every selected field, all in fixed-width hexadecimal.
+		/// @note Samples that do not fit in the output queue, or that would interleave with a listing, are dropped.
+		/// The sequence number still advances, so gaps show up on the other end.
+		void streamSample() {
+			uint8 const sequence = stream.sequence++;
+			if (listing || wipe.busy() || out.room() < streamLineSize()) return;
+			int16 fields[FIELDS];
+			memcpy(fields, &value, sizeof(fields));
+			out.write('>');
+			out.printHex(sequence, 2);
+			for (uint8 i = 0; i < FIELDS; ++i)
+				if (stream.mask & (1u << i))
+					out.printHex(fields[i], 4);
+			out.println();
+		}
+
+		/// @brief Returns the memory usage, as a machine mode payload.
+		/// @return `data,free,untouched,stack,heap,heapfree,heapmax,logger`, in bytes.
+		String memoryValues() const {
+			Memory::track();
+			return
+				String(Memory::data())			+ ","
+			+	String(Memory::available())		+ ","
+			+	String(Memory::untouched())		+ ","
+			+	String(Memory::stackMax())		+ ","
+			+	String(Memory::heapSize())		+ ","
+			+	String(Memory::heapFree())		+ ","
+			+	String(Memory::heapMax())		+ ","
+			+	String(sizeof(DataLogger))
+			;
+		}
+
+		/// @brief Prints the memory usage, and how much each part of the logger takes up.
+		void printMemory() {
+			// Measured before anything is printed, since printing takes up stack.
+			Memory::track();
+			uint16 const	data		= Memory::data();
+			uint16 const	available	= Memory::available();
+			uint16 const	untouched	= Memory::untouched();
+			uint16 const	stack		= Memory::stackMax();
+			out.print(F("Static data: "));		out.print(data);		out.println(F(" bytes"));
+			out.print(F("Free: "));				out.print(available);	out.print(F(" bytes, never used: "));	out.println(untouched);
+			out.print(F("Stack peak: "));		out.print(stack);		out.println(F(" bytes"));
+			out.print(F("Heap: "));				out.print(Memory::heapSize());
+			out.print(F(" bytes, free blocks: "));	out.print(Memory::heapFree());
+			out.print(F(", peak: "));				out.println(Memory::heapMax());
+			out.println(F(""));
+			printSize(F("Logger"),		sizeof(DataLogger));
+			printSize(F("  info"),		sizeof(info));
+			printSize(F("  clock"),		sizeof(clock));
+			printSize(F("  channels"),	sizeof(channels));
+			printSize(F("  db"),		sizeof(db));
+			printSize(F("  retention"),	sizeof(retention));
+			printSize(F("  staging"),	sizeof(staging));
+			printSize(F("  display"),	sizeof(display));
+			printSize(F("  logo"),		sizeof(logo));
+			printSize(F("  watchdog"),	sizeof(watchdog));
+			printSize(F("  power"),		sizeof(power));
+			printSize(F("  out"),		sizeof(out));
+			printSize(F("  cursor"),	sizeof(cursor));
+			printSize(F("  wipe"),		sizeof(wipe));
+			printSize(F("  stream"),	sizeof(stream));
+			printSize(F("  alarm"),		sizeof(alarm));
+			printSize(F("Serial"),		sizeof(Serial));
+		}
+
+		/// @brief Prints the size of an object.
+		/// @param name Object name.
+		/// @param size Object size, in bytes.
+		void printSize(__FlashStringHelper const* const name, uint16 const size) {
+			out.print(name);
+			out.print(F(": "));
+			out.println(size);
+		}
+
+		/// @brief Advances the EEPROM wipe, and reports its progress. Resets once the wipe is complete and verified.
+		void continueWipe() {
+			wipe.update();
+			bool const machine = info.get().machineMode;
+			if (wipe.busy()) {
+				if (machine) return;
+				if (wipe.verifying()) {
+					if (wipeReport <= 100) {
+						out.println(F("Verifying..."));
+						wipeReport = 101;
+					}
+				} else if (wipe.progress() >= wipeReport) {
+					out.print(wipe.progress());
+					out.println(F("%"));
+					wipeReport = wipe.progress() / 10 * 10 + 10;
 				}
-				Serial.println("Command-line ready.");
+				return;
 			}
+			if (machine) out.println(F("0"));
+			else out.println(F("EEPROM wiped. Resetting..."));
+			out.drain();
+			reset(RESET_WIPE);
+		}
+
+		/// @brief Prints the closing lines of a command's response, and applies any pending baud rate change.
+		/// @param type Response type.
+		/// @param payload Machine mode payload.
+		void finishCommand(ParserType::Response::Type const type, String const& payload = "") {
+			if (info.get().machineMode) {
+				out.print(static_cast<uint8>(type));
+				if (payload.length()) {
+					out.print(',');
+					out.print(payload);
+				}
+				out.println();
+			}
+			if (!transaction.active) {
+				if (!info.get().machineMode)
+					out.println(F("Command-line ready."));
+				if (changeBaud) {
+					changeBaud = false;
+					setBaud(Baud::rate(info.get().baudRate));
+				}
+			}
+		}
+
+		/// @brief Checks the latest samples, sounds the alarm and updates the display. Runs once every `TICK_INTERVAL`.
+		void tick() {
 			if (!info.get().ok()) {
+				alarm.play(Alarm::Pattern::BAP_NONE);
 				setLights(LightDisplay::BDLLD_CONFIG_ERROR);
 				return;
 			}
-			if (!screenCooldown) {
-				bool const inTheDangerZone = sensor.inTheDangerZone() || ldr.inTheDangerZone();
-				if (inTheDangerZone) {
-					if (!cooldown) {
-						db.record({
-							clock.unixNow(),
-							sensor.readRaw(),
-							ldr.read()
-						});
-						cooldown = 15;
-					}
-					tone(alarm, NOTE_C6, 500);
-					setLights(LightDisplay::BDLLD_EMERGENCY);
-				} else {
-					tone(alarm, NOTE_C5, 100);
-					cooldown = 1;
-					setLights(LightDisplay::BDLLD_OK);
+			// Until every channel has actually measured something, there is nothing to check, or to log.
+			auto const pattern = channels.measured(value) ? channels.check(value) : Alarm::Pattern::BAP_NONE;
+			alarm.play(pattern);
+			if (pattern == Alarm::Pattern::BAP_NONE)
+				setLights(LightDisplay::BDLLD_WAITING);
+			else if (pattern != Alarm::Pattern::BAP_OK) {
+				if (!cooldown && !wipe.busy()) {
+					staging.record({
+						clock.unixNow(),
+						value
+					});
+					cooldown = 15;
 				}
-				if (cooldown) --cooldown;
+				setLights(LightDisplay::BDLLD_EMERGENCY);
+			} else {
+				cooldown = 1;
+				setLights(LightDisplay::BDLLD_OK);
 			}
-			updateScreen();
-			Wait::millis(1);
+			if (cooldown) --cooldown;
+			watchdog.enter(Watchdog::Stage::BWS_DISPLAY);
+			if (!logo.running())
+				updateScreen(value);
 		}
 
-	private:
-		/// @brief Updates the data logger's display.
-		void updateScreen() {
-			if (screenCooldown) {
-				--screenCooldown;
+		/// @brief Commits any settled configuration changes to the EEPROM.
+		void updateRecords() {
+			info.update();
+			clock.update();
+			channels.update();
+		}
+
+		/// @brief Commits all pending configuration changes to the EEPROM immediately.
+		void saveRecords() {
+			info.save();
+			clock.save();
+			channels.save();
+		}
+
+		/// @brief Discards all pending configuration changes.
+		void revertRecords() {
+			info.revert();
+			clock.revert();
+			channels.revert();
+		}
+
+		/// @brief Opens a configuration transaction. Anything still pending is committed first.
+		/// @param quiet Whether to skip the human-readable report.
+		void beginTransaction(bool const quiet) {
+			saveRecords();
+			transaction = {};
+			transaction.active = true;
+			if (!quiet)
+				out.println(F("Transaction started. Changes are staged until @commit, or discarded on @abort."));
+		}
+
+		/// @brief Applies and commits every staged change, in a single pass.
+		/// @param quiet Whether to skip the human-readable report.
+		void commitTransaction(bool const quiet) {
+			if (transaction.dated)
+				clock.adjust(DateTime(transaction.date));
+			saveRecords();
+			if (!quiet) {
+				out.print(F("Committed "));
+				out.print(transaction.changes);
+				out.println(F(" change(s)."));
+			}
+			transaction = {};
+		}
+
+		/// @brief Discards every staged change.
+		/// @param quiet Whether to skip the human-readable report.
+		void abortTransaction(bool const quiet) {
+			revertRecords();
+			changeBaud = false;
+			if (!quiet) {
+				out.print(F("Discarded "));
+				out.print(transaction.changes);
+				out.println(F(" change(s)."));
+			}
+			transaction = {};
+		}
+
+		/// @brief Human-readable response messages, by response type.
+		constexpr static char const MSG_OK[]				PROGMEM = "Operation completed successfully.";
+		constexpr static char const MSG_NOT_A_COMMAND[]		PROGMEM = "Not a command string. Commands start with '@'.";
+		constexpr static char const MSG_MISSING_COMMAND[]	PROGMEM = "";
+		constexpr static char const MSG_INVALID_COMMAND[]	PROGMEM = "Unknown/Invalid/Unsupported command. Did you perhaps misspell it?";
+		constexpr static char const MSG_MISSING_ARGUMENT[]	PROGMEM = "Missing necessary argument(s) for command.";
+		constexpr static char const MSG_INVALID_ARGUMENT[]	PROGMEM = "Unknown/Invalid/Unsupported argument(s). Did you perhaps misspell one or more?";
+		constexpr static char const MSG_MISSING_VALUE[]		PROGMEM = "Missing necessary value(s) for command.";
+		constexpr static char const MSG_INVALID_VALUE[]		PROGMEM = "Invalid value(s) for argument. Did you perhaps mistype/misarrange them?";
+
+		constexpr static char const* const MESSAGES[] PROGMEM = {
+			MSG_OK,
+			MSG_NOT_A_COMMAND,
+			MSG_MISSING_COMMAND,
+			MSG_INVALID_COMMAND,
+			MSG_MISSING_ARGUMENT,
+			MSG_INVALID_ARGUMENT,
+			MSG_MISSING_VALUE,
+			MSG_INVALID_VALUE,
+		};
+
+		static_assert(sizeof(MESSAGES) / sizeof(MESSAGES[0]) == static_cast<uint8>(ParserType::Response::Type::BPRT_INVALID_VALUE) + 1);
+
+		/// @brief Prints the human-readable message of a response type.
+		/// @param type Response type.
+		void printMessage(ParserType::Response::Type const type) {
+			auto const index = static_cast<uint8>(type);
+			if (index >= sizeof(MESSAGES) / sizeof(MESSAGES[0]))
+				return (void)out.println(F("Unknown error. Sorry :/"));
+			auto const msg = reinterpret_cast<__FlashStringHelper const*>(pgm_read_ptr(&MESSAGES[index]));
+			if (pgm_read_byte(msg))
+				out.println(msg);
+		}
+
+		/// @brief Flags any configuration that was restored to its defaults at boot.
+		/// @param wiped Whether the EEPROM was wiped on request, in which case nothing is reported as corrupted.
+		void checkRecords(bool const wiped) {
+			auto i = info.get();
+			bool const intact = (
+				info.valid()
+			&&	clock.valid()
+			&&	channels.valid()
+			&&	db.valid()
+			);
+			if (intact && !i.restored) return;
+			i.restored = !intact && !wiped;
+			if (!clock.valid())		i.clockOK = false;
+			if (!channels.valid())
+				i.temperatureOK = i.humidityOK = i.luminosityOK = i.calibrationOK = false;
+			info = i;
+		}
+
+		/// @brief Fallback window, in milliseconds, during which the serial interface stays at the default baud rate.
+		constexpr static uint16 const BAUD_FALLBACK_WINDOW = 3000;
+
+		/// @brief Announces the configured baud rate, and opens the fallback window. The switch itself happens in `awaitFallback()`.
+		void beginSerial() {
+			auto const& i = info.get();
+			uint32 const rate = Baud::rate(i.baudRate);
+			if (rate == Baud::RATES[0]) return;
+			if (!i.machineMode) {
+				out.print(F("Switching to "));
+				out.print(rate);
+				out.print(F(" baud. Send anything within "));
+				out.print(BAUD_FALLBACK_WINDOW / 1000);
+				out.println(F("s to stay at the default rate."));
+			}
+			fallback		= true;
+			fallbackStart	= millis();
+		}
+
+		/// @brief Waits out the fallback window, without blocking the loop.
+		/// @details If anything is received during the window, the default baud rate is kept and restored.
+		/// Otherwise, switches to the configured baud rate once the window closes.
+		void awaitFallback() {
+			auto i = info.get();
+			if (Serial.available()) {
+				while (Serial.available())
+					Serial.read();
+				fallback	= false;
+				i.baudRate	= 0;
+				info		= i;
+				if (!i.machineMode)
+					out.println(F("Baud rate reset to default."));
+				printReady();
 				return;
 			}
-			screenCooldown = 1000;
+			if (millis() - fallbackStart < BAUD_FALLBACK_WINDOW) return;
+			fallback = false;
+			setBaud(Baud::rate(i.baudRate));
+			printReady();
+		}
+
+		/// @brief Prints the boot greeting, once the serial interface is at its final baud rate.
+		void printReady() {
+			auto const& i = info.get();
+			if (i.machineMode)
+				out.println(i.restored ? F("0,1") : F("0"));
+			else {
+				if (i.restored)
+					out.println(F("Corrupted or outdated configuration was restored to defaults. Please reconfigure."));
+				out.println(F("Command-line ready."));
+			}
+		}
+
+		/// @brief Changes the serial interface's baud rate, once all pending output has been sent.
+		/// @param rate Baud rate to set.
+		void setBaud(uint32 const rate) {
+			out.drain();
+			Serial.flush();
+			Serial.end();
+			Serial.begin(rate);
+			paceStream(rate);
+		}
+
+		/// @brief Updates the data logger's display.
+		/// @param value Channel readings to show.
+		void updateScreen(ChannelsType::Reading const& value) {
 			auto const now = clock.now();
 			String const ts = 
 				now.timestamp(DateTime::TIMESTAMP_DATE)
@@ -215,68 +771,12 @@ namespace Bits {
 			;
 			display.clear();
 			display.write(ts);
-			auto const v = sensor.read();
 			if (switchTimer) --switchTimer;
 			else {
 				switchTimer = 5;
-				showHumidity = !showHumidity;
-			}
-			if (showHumidity) {
-				display.setCursorPosition(0, 1);
-				display.write("Luminosity: ");
-				writeInt(ldr.read(), '%', 11, 1);
-			} else {
-				writeDecimal(v.temperature, static_cast<char>(sensor.getUnit()), 1, 1);
-				writeDecimal(v.humidity, '%', 8, 1);
-			}
-		}
-
-		/// @brief Writes an integer to the display.
-		/// @param val Value to write.
-		/// @param append Character to append.
-		/// @param x X position to write in.
-		/// @param y Y position to write in.
-		/// @param maxDigits Maximum amount of digits to write.
-		void writeInt(int32 const val, char const append, uint8 const x, uint8 const y) {
-			display.setCursorPosition(x, y);
-			if (val < 0) {
-				display.write('-');
-				return writeInt(-val, append, x+1, y);
-			} else {
-				display.write(' ');
-				if (val < 100)
-					display.write('0');
-				if (val < 10)
-					display.write('0');
-				display.write(val, 10);
-				display.write(append);
-			}
-		}
-		
-		/// @brief Writes a decimal value to the display.
-		/// @param cents Value (in cents) to write.
-		/// @param append Character to append.
-		/// @param x X position to write in.
-		/// @param y Y position to write in.
-		void writeDecimal(int32 const cents, char const append, uint8 const x, uint8 const y) {
-			display.setCursorPosition(x, y);
-			if (cents < 0) {
-				display.write('-');
-				return writeDecimal(-cents, append, x+1, y);
-			} else {
-				display.write(' ');
-				auto const
-					num = static_cast<uint32>(cents) / 100,
-					frac = static_cast<uint32>(cents) % 100
-				;
-				if (num < 10)
-					display.write('0');
-				display.write(num, 10);
-				display.write('.');
-				display.write(frac / 10, 10);
-				display.setCursorPosition(x + 5, y);
-				display.write(append);
+				page = (page + 1) % ChannelsType::PAGES;
 			}
+			channels.show(display, value, page);
 		}
 
 		/// @brief Sets the light indicator state.
@@ -289,21 +789,38 @@ namespace Bits {
 				case (LightDisplay::BDLLD_OK):				digitalWrite(led.green,		HIGH);	break;
 				case (LightDisplay::BDLLD_CONFIG_ERROR):	digitalWrite(led.yellow,	HIGH);	break;
 				case (LightDisplay::BDLLD_EMERGENCY):		digitalWrite(led.red,		HIGH);	break;
+				case (LightDisplay::BDLLD_WAITING):											break;
 			}
 		}
 
-		bool showHumidity = false;
+		uint8 page = 0;
 		uint32 switchTimer = 5;
-		Record<Info>	info;
+		InfoRecord		info;
 		Clock			clock;
-		Sensor			sensor;
-		LDR				ldr;
-		DataBank<Log>	db;
+		ChannelsType	channels;
+		DataBankType	db;
+		RetentionType	retention;
+		Staging<DataBankType>	staging;
 		Display			display;
+		Logo			logo;
 		uint8			cooldown		= 0;
-		uint16			screenCooldown	= 0;
+		uint32			lastTick		= 0;
+		uint32			lastSample		= 0;
+		ChannelsType::Reading	value;
+		Watchdog		watchdog;
+		Power			power;
+		bool			changeBaud		= false;
+		bool			fallback		= false;
+		uint32			fallbackStart	= 0;
+		Transaction		transaction;
+		Output<>		out;
+		bool			listing			= false;
+		DataBankType::Cursor	cursor;
+		Wipe<>			wipe;
+		Stream			stream;
+		uint8			wipeReport		= 0;
 		LEDPins			led;
-		avr_pin			alarm;
+		Alarm			alarm;
 	};
 }
 
@@ -2,6 +2,7 @@
 #define BITS_DISPLAY_H
 
 #include "types.hpp"
+#include "units.hpp"
 
 #include <LiquidCrystal_I2C.h>
 
@@ -79,6 +80,12 @@ namespace Bits {
 			lcd.createChar(character.id, character.data);
 		}
 
+		void addCharacter(Character const* const character) {
+			Character c;
+			memcpy_P(&c, character, sizeof(Character));
+			addCharacter(c);
+		}
+
 		void write(char const c) {
 			lcd.write(c);
 		}
@@ -92,6 +99,54 @@ namespace Bits {
 			lcd.print(v, base);
 		}
 
+		/// @brief Writes an integer.
+		/// @param val Value to write.
+		/// @param append Character to append.
+		/// @param x X position to write in.
+		/// @param y Y position to write in.
+		void writeInt(int32 const val, char const append, uint8 const x, uint8 const y) {
+			setCursorPosition(x, y);
+			if (val < 0) {
+				write('-');
+				return writeInt(-val, append, x+1, y);
+			} else {
+				write(' ');
+				if (val < 100)
+					write('0');
+				if (val < 10)
+					write('0');
+				write(val, 10);
+				write(append);
+			}
+		}
+		
+		/// @brief Writes a decimal value.
+		/// @param cents Value (in cents) to write.
+		/// @param append Character to append.
+		/// @param x X position to write in.
+		/// @param y Y position to write in.
+		void writeDecimal(int32 const cents, char const append, uint8 const x, uint8 const y) {
+			setCursorPosition(x, y);
+			if (cents < 0) {
+				write('-');
+				return writeDecimal(-cents, append, x+1, y);
+			} else {
+				write(' ');
+				auto const
+					tenths	= static_cast<uint32>(Units::round(cents, 1)),
+					num		= tenths / 10,
+					frac	= tenths % 10
+				;
+				if (num < 10)
+					write('0');
+				write(num, 10);
+				write('.');
+				write(frac, 10);
+				setCursorPosition(x + 5, y);
+				write(append);
+			}
+		}
+
 		void clear() {lcd.clear();}
 
 	private:
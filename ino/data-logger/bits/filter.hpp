@@ -0,0 +1,157 @@
+#ifndef BITS_FILTER_H
+#define BITS_FILTER_H
+
+#include "types.hpp"
+#include "units.hpp"
+
+/// @brief Helper classes & functions.
+namespace Bits {
+	/// @brief Signal filter stages.
+	/// @details Each stage processes one `int16` sample at a time, with `bool apply(int16& v)`.
+	/// Returning `false` drops the sample. All state lives in fixed-size buffers, and all math is integer math.
+	namespace Filters {
+		/// @brief Outlier rejection.
+		/// @details Drops failed readings (`Units::MISSING`) and saturated ones, which never count as the last accepted sample,
+		/// and samples that jump more than `MAX_STEP` away from the last accepted one.
+		/// After `LIMIT` consecutive jumps, the new level is accepted as a real change.
+		/// @tparam MAX_STEP Maximum difference between consecutive samples.
+		/// @tparam LIMIT Maximum amount of consecutive samples to drop.
+		template <uint16 MAX_STEP, uint8 LIMIT = 3>
+		struct Reject {
+			bool apply(int16& v) {
+				if (v == Units::MISSING || v == INT16_MAX) return false;
+				int32 const step = static_cast<int32>(v) - last;
+				if (primed && (step > MAX_STEP || -step > MAX_STEP) && strikes < LIMIT) {
+					++strikes;
+					return false;
+				}
+				primed	= true;
+				strikes	= 0;
+				last	= v;
+				return true;
+			}
+
+		private:
+			int16	last	= 0;
+			uint8	strikes	= 0;
+			bool	primed	= false;
+		};
+
+		/// @brief Median of the last `N` samples.
+		/// @tparam N Window size. Should be odd.
+		template <uint8 N>
+		struct Median {
+			static_assert(N > 0 && N < 16);
+
+			bool apply(int16& v) {
+				window[head] = v;
+				head = (head + 1) % N;
+				if (count < N) ++count;
+				int16 sorted[N];
+				for (uint8 i = 0; i < count; ++i) {
+					uint8 j = i;
+					for (; j > 0 && sorted[j-1] > window[i]; --j)
+						sorted[j] = sorted[j-1];
+					sorted[j] = window[i];
+				}
+				v = sorted[count / 2];
+				return true;
+			}
+
+		private:
+			int16	window[N];
+			uint8	head	= 0;
+			uint8	count	= 0;
+		};
+
+		/// @brief Integer exponential moving average, with a smoothing factor of `1 / 2^SHIFT`.
+		/// @tparam SHIFT Smoothing shift. Higher is smoother (and slower).
+		template <uint8 SHIFT>
+		struct EMA {
+			static_assert(SHIFT > 0 && SHIFT < 16);
+
+			bool apply(int16& v) {
+				if (!primed) {
+					state	= static_cast<int32>(v) * ONE;
+					primed	= true;
+				} else state += v - value();
+				v = value();
+				return true;
+			}
+
+		private:
+			constexpr static int32 const ONE = 1l << SHIFT;
+
+			/// @brief Returns the current average, rounded.
+			int16 value() const {return (state + ONE / 2) >> SHIFT;}
+
+			int32	state	= 0;
+			bool	primed	= false;
+		};
+	}
+
+	/// @brief Signal filter pipeline.
+	/// @tparam Stages Filter stages, in processing order (e.g. `Filter<Filters::Reject<500>, Filters::Median<3>>`).
+	template <class... Stages>
+	struct Filter;
+
+	template <>
+	struct Filter<> {
+		bool apply(int16&) {return true;}
+	};
+
+	template <class S, class... Stages>
+	struct Filter<S, Stages...> {
+		/// @brief Runs a sample through the pipeline.
+		/// @param v Sample to process.
+		/// @return Filtered value. If the sample was dropped, the previous filtered value, or `Units::MISSING` if none made it through yet.
+		int16 push(int16 v) {
+			if (apply(v))
+				output = v;
+			return output;
+		}
+
+		/// @brief Runs a sample through the stages.
+		/// @return Whether the sample made it through.
+		bool apply(int16& v) {
+			return stage.apply(v) && rest.apply(v);
+		}
+
+	private:
+		S					stage;
+		Filter<Stages...>	rest;
+		int16				output	= Units::MISSING;
+	};
+
+	/// @brief Channel with a filter stage between acquisition and evaluation.
+	/// @details Every `int16` field of the channel's readings goes through its own copy of the pipeline.
+	/// @tparam C Channel type.
+	/// @tparam F Filter pipeline type.
+	template <class C, class F>
+	struct Filtered: C {
+		using typename C::Reading;
+
+		using C::C;
+
+		/// @brief Takes a filtered reading.
+		Reading sample() {
+			Reading r = C::sample();
+			int16 fields[FIELDS];
+			memcpy(fields, &r, sizeof(Reading));
+			for (uint8 i = 0; i < FIELDS; ++i)
+				fields[i] = filters[i].push(fields[i]);
+			memcpy(&r, fields, sizeof(Reading));
+			return r;
+		}
+
+	private:
+		/// @brief Amount of `int16` fields in a reading.
+		constexpr static uint8 const FIELDS = sizeof(Reading) / sizeof(int16);
+
+		static_assert(sizeof(Reading) == FIELDS * sizeof(int16), "Filtered channel readings must be made of int16 fields!");
+
+		F filters[FIELDS];
+	};
+}
+
+#endif
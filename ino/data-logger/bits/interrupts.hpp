@@ -3,33 +3,234 @@
 
 #include "types.hpp"
 
+/*
+	Each vector's ISR is only defined if its `BITS_ISR_<VECTOR>` macro is non-zero.
+	Vectors the Arduino core & its libraries already define (Timer0 overflow for `millis()`, Timer2 for `tone()`,
+	the USART for `Serial` and the TWI for `Wire`) are disabled by default. To take one over, define its macro
+	as `1` before including this file.
+*/
+
+#ifndef BITS_ISR_INT0
+#define BITS_ISR_INT0			1
+#endif
+#ifndef BITS_ISR_INT1
+#define BITS_ISR_INT1			1
+#endif
+#ifndef BITS_ISR_PCINT
+#define BITS_ISR_PCINT			1
+#endif
+#ifndef BITS_ISR_WDT
+#define BITS_ISR_WDT			1
+#endif
+#ifndef BITS_ISR_TIMER0_COMP
+#define BITS_ISR_TIMER0_COMP	1
+#endif
+#ifndef BITS_ISR_TIMER0_OVF
+#define BITS_ISR_TIMER0_OVF		0
+#endif
+#ifndef BITS_ISR_TIMER1
+#define BITS_ISR_TIMER1			1
+#endif
+#ifndef BITS_ISR_TIMER2
+#define BITS_ISR_TIMER2			0
+#endif
+#ifndef BITS_ISR_USART
+#define BITS_ISR_USART			0
+#endif
+#ifndef BITS_ISR_USART_TX
+#define BITS_ISR_USART_TX		1
+#endif
+#ifndef BITS_ISR_ADC
+#define BITS_ISR_ADC			1
+#endif
+#ifndef BITS_ISR_EE_READY
+#define BITS_ISR_EE_READY		1
+#endif
+#ifndef BITS_ISR_ANALOG_COMP
+#define BITS_ISR_ANALOG_COMP	1
+#endif
+#ifndef BITS_ISR_TWI
+#define BITS_ISR_TWI			0
+#endif
+
 namespace Bits {
-	using Interrupt = void();
+	/// @brief Interrupt callback.
+	/// @param context Context the callback was registered with.
+	using Interrupt = void(pointer const context);
+
+	/// @brief Interrupt vectors.
+	enum class Vector: uint8 {
+		BV_INT0,
+		BV_INT1,
+		BV_PCINT0,
+		BV_PCINT1,
+		BV_PCINT2,
+		BV_WDT,
+		BV_TIMER2_COMPA,
+		BV_TIMER2_COMPB,
+		BV_TIMER2_OVF,
+		BV_TIMER1_CAPT,
+		BV_TIMER1_COMPA,
+		BV_TIMER1_COMPB,
+		BV_TIMER1_OVF,
+		BV_TIMER0_COMPA,
+		BV_TIMER0_COMPB,
+		BV_TIMER0_OVF,
+		BV_USART_RX,
+		BV_USART_UDRE,
+		BV_USART_TX,
+		BV_ADC,
+		BV_EE_READY,
+		BV_ANALOG_COMP,
+		BV_TWI,
+	};
+
+	/// @brief Interrupt handler registry for a given vector.
+	/// @details Each vector gets its own static handler, so there is no table lookup when dispatching.
+	/// @tparam V Interrupt vector.
+	template <Vector V>
+	struct Interrupts {
+		/// @brief Sets the vector's handler.
+		/// @param callback Callback to call.
+		/// @param context Context to pass to the callback.
+		static void set(ref<Interrupt> const callback, pointer const context = nullptr) {
+			uint8 const sreg = SREG;
+			cli();
+			handler.callback	= callback;
+			handler.context		= context;
+			SREG = sreg;
+		}
+
+		/// @brief Sets an object's member function as the vector's handler.
+		/// @tparam M Member function to call.
+		/// @tparam T Object type.
+		/// @param object Object to call the member function on.
+		template <auto M, class T>
+		static void bind(T& object) {
+			set([] (pointer const context) {(static_cast<T*>(context)->*M)();}, &object);
+		}
+
+		/// @brief Removes the vector's handler.
+		static void clear() {set(nullptr);}
+
+		/// @brief Calls the vector's handler, if any.
+		[[gnu::always_inline]]
+		static inline void dispatch() {
+			if (handler.callback)
+				handler.callback(handler.context);
+		}
+
+	private:
+		/// @brief Registered handler.
+		struct Handler {
+			ref<Interrupt>	callback	= nullptr;
+			pointer			context		= nullptr;
+		};
 
-	enum class InterruptType {
-		BIT_COMPARE_A,
-		BIT_COMPARE_B,
-		BIT_OVERFLOW,
-		BIT_CAPTURE,
+		/// @brief Vector's handler.
+		inline static Handler handler;
 	};
 
 	namespace {
-		static ref<Interrupt> iCompareA = nullptr, iCompareB = nullptr, iOverflow = nullptr, iCapture = nullptr;
+		#define BITS_DISPATCH(VECTOR) ISR(VECTOR##_vect) {Interrupts<Vector::BV_##VECTOR>::dispatch();}
+
+		#if BITS_ISR_INT0
+		BITS_DISPATCH(INT0)
+		#endif
+		#if BITS_ISR_INT1
+		BITS_DISPATCH(INT1)
+		#endif
+		#if BITS_ISR_PCINT
+		BITS_DISPATCH(PCINT0)
+		BITS_DISPATCH(PCINT1)
+		BITS_DISPATCH(PCINT2)
+		#endif
+		#if BITS_ISR_WDT
+		BITS_DISPATCH(WDT)
+		#endif
+		#if BITS_ISR_TIMER2
+		BITS_DISPATCH(TIMER2_COMPA)
+		BITS_DISPATCH(TIMER2_COMPB)
+		BITS_DISPATCH(TIMER2_OVF)
+		#endif
+		#if BITS_ISR_TIMER1
+		BITS_DISPATCH(TIMER1_CAPT)
+		BITS_DISPATCH(TIMER1_COMPA)
+		BITS_DISPATCH(TIMER1_COMPB)
+		BITS_DISPATCH(TIMER1_OVF)
+		#endif
+		#if BITS_ISR_TIMER0_COMP
+		BITS_DISPATCH(TIMER0_COMPA)
+		BITS_DISPATCH(TIMER0_COMPB)
+		#endif
+		#if BITS_ISR_TIMER0_OVF
+		BITS_DISPATCH(TIMER0_OVF)
+		#endif
+		#if BITS_ISR_USART
+		BITS_DISPATCH(USART_RX)
+		BITS_DISPATCH(USART_UDRE)
+		#endif
+		#if BITS_ISR_USART_TX
+		BITS_DISPATCH(USART_TX)
+		#endif
+		#if BITS_ISR_ADC
+		BITS_DISPATCH(ADC)
+		#endif
+		#if BITS_ISR_EE_READY
+		BITS_DISPATCH(EE_READY)
+		#endif
+		#if BITS_ISR_ANALOG_COMP
+		BITS_DISPATCH(ANALOG_COMP)
+		#endif
+		#if BITS_ISR_TWI
+		BITS_DISPATCH(TWI)
+		#endif
 
-		ISR(TIM1_COMPA_vect)	{if (iCompareA)	iCompareA();	}
-		ISR(TIM1_COMPB_vect)	{if (iCompareB)	iCompareB();	}
-		ISR(TIM1_OVF_vect)		{if (iOverflow)	iOverflow();	}
-		ISR(TIM1_CAPT_vect)		{if (iCapture)	iCapture();		}
+		#undef BITS_DISPATCH
 	}
 
-	inline void setTimer1Interrupt(InterruptType const type, ref<Interrupt> const interrupt) {
-		switch (type) {
-			case InterruptType::BIT_COMPARE_A:	iCompareA	= interrupt; break;
-			case InterruptType::BIT_COMPARE_B:	iCompareB	= interrupt; break;
-			case InterruptType::BIT_OVERFLOW:	iOverflow	= interrupt; break;
-			case InterruptType::BIT_CAPTURE:	iCapture	= interrupt; break;
+	/// @brief Periodic timer service, running on Timer1 (compare match A).
+	struct PeriodicTimer {
+		/// @brief Longest possible period, in microseconds.
+		constexpr static uint32 const MAX_PERIOD = 65536ul * 1024ul / (F_CPU / 1000000ul);
+
+		/// @brief Starts calling a function periodically.
+		/// @param period Period, in microseconds. Clamped to `MAX_PERIOD`.
+		/// @param callback Callback to call.
+		/// @param context Context to pass to the callback.
+		static void start(uint32 const period, ref<Interrupt> const callback, pointer const context = nullptr) {
+			constexpr uint16 const PRESCALERS[] = {1, 8, 64, 256, 1024};
+			uint32 const ticks = ((period < MAX_PERIOD) ? period : MAX_PERIOD) * (F_CPU / 1000000ul);
+			uint8 clock = 0;
+			while (clock < 4 && ticks / PRESCALERS[clock] > 65536ul)
+				++clock;
+			uint32 const top = ticks / PRESCALERS[clock];
+			stop();
+			Interrupts<Vector::BV_TIMER1_COMPA>::set(callback, context);
+			TCCR1A	= 0;
+			TCNT1	= 0;
+			OCR1A	= top ? top - 1 : 0;
+			TCCR1B	= _BV(WGM12) | (clock + 1);
+			TIMSK1	|= _BV(OCIE1A);
 		}
-	}
+
+		/// @brief Starts calling an object's member function periodically.
+		/// @tparam M Member function to call.
+		/// @tparam T Object type.
+		/// @param period Period, in microseconds.
+		/// @param object Object to call the member function on.
+		template <auto M, class T>
+		static void start(uint32 const period, T& object) {
+			start(period, [] (pointer const context) {(static_cast<T*>(context)->*M)();}, &object);
+		}
+
+		/// @brief Stops the timer.
+		static void stop() {
+			TIMSK1	&= ~_BV(OCIE1A);
+			TCCR1B	= 0;
+			Interrupts<Vector::BV_TIMER1_COMPA>::clear();
+		}
+	};
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,48 @@
+#ifndef BITS_LAYOUT_H
+#define BITS_LAYOUT_H
+
+#include "types.hpp"
+#include "databank.hpp"
+
+/// @brief Helper classes & functions.
+namespace Bits {
+	/// @brief Compile-time EEPROM layout.
+	/// @details Objects are laid out back-to-back, in the given order, starting at `BASE`.
+	/// Since the AVR has no alignment requirements, this is both packed and aligned, and objects never overlap.
+	/// @tparam BASE EEPROM address the layout starts at.
+	/// @tparam Ts Persistent object types (`Record`s, `DataBank`s...). Each must declare its total EEPROM footprint as `SIZE`.
+	template <eeprom_address BASE, class... Ts>
+	struct Layout {
+		/// @brief Amount of objects in the layout.
+		constexpr static usize const COUNT = sizeof...(Ts);
+
+		static_assert(COUNT > 0);
+
+		/// @brief Size of each object in the layout.
+		constexpr static uint32 const SIZES[COUNT] = {Ts::SIZE...};
+
+		/// @brief Returns the EEPROM address of an object in the layout.
+		/// @tparam I Object index. `COUNT` returns one-past-the-end of the layout.
+		/// @return Address of object.
+		template <usize I>
+		constexpr static uint32 address() {
+			static_assert(I <= COUNT);
+			uint32 addr = BASE;
+			for (usize i = 0; i < I; ++i)
+				addr += SIZES[i];
+			return addr;
+		}
+
+		/// @brief One-past-the-end of the layout.
+		constexpr static uint32 const END	= address<COUNT>();
+		/// @brief Total size of the layout.
+		constexpr static uint32 const SIZE	= END - BASE;
+
+		static_assert(END <= EEPROM_SIZE, "EEPROM layout does not fit in the EEPROM!");
+
+		/// @brief Bytes left in the EEPROM after the layout.
+		constexpr static usize const FREE	= EEPROM_SIZE - END;
+	};
+}
+
+#endif
@@ -3,6 +3,9 @@
 
 #include "types.hpp"
 #include "record.hpp"
+#include "units.hpp"
+#include "alarm.hpp"
+#include "display.hpp"
 
 namespace Bits {
 	struct LDR {
@@ -22,6 +25,14 @@ namespace Bits {
 			Threshold	threshold;
 		};
 
+		using InfoRecord = Record<Info, CacheType::BCT_CACHE_WRITE_BACK>;
+
+		using Reading = int16;
+
+		constexpr static uint8 const PAGES = 1;
+
+		constexpr static uint16 const INTERVAL = 10;
+
 		LDR(avr_pin const pin, eeprom_address const info):
 			pin(pin), info(info) {
 		}
@@ -29,12 +40,23 @@ namespace Bits {
 		void begin() {
 			pinMode(pin, INPUT);
 			info.begin();
+			apply();
 		}
 
+		void update()	{info.update();	}
+		void save()		{info.save();	}
+		void revert()	{info.revert();	}
+
+		/// @brief Makes the configured thresholds & adjustment the ones `check()` uses.
+		void apply()	{safe = compile(info.get());	}
+
 		int16 read() const {
-			auto const v	= readRaw();
-			auto const adj	= info.get().adjustment;
-			return constrain(100 - map(v, adj.min, adj.max, 0, 100), 0, 100);
+			return percent(readRaw());
+		}
+
+		/// @brief Converts a raw ADC reading into a luminosity percentage, with the current adjustment.
+		int16 percent(int16 const raw) const {
+			return percent(raw, info.get().adjustment);
 		}
 
 		int16 readRaw() const {
@@ -66,20 +88,90 @@ namespace Bits {
 		}
 
 		bool inTheSafeZone() const {
-			auto const v			= read();
-			auto const threshold	= info.get().threshold;
+			return inTheSafeZone(readRaw());
+		}
+
+		/// @brief Checks a raw ADC reading against the thresholds, compiled into the raw domain as of the last `apply()`.
+		bool inTheSafeZone(int16 const raw) const {
 			return (
-				threshold.min <= v
-			&&	v <= threshold.max
+				safe.min <= raw
+			&&	raw <= safe.max
 			);
 		}
 
+		/// @brief Takes a raw ADC reading. Converted to a percentage only for display & logging.
+		Reading sample() const {
+			return readRaw();
+		}
+
+		/// @brief Returns whether a reading holds an actual measurement. Only a filter that has let nothing through yet yields none.
+		constexpr static bool measured(Reading const v) {
+			return v != Units::MISSING;
+		}
+
+		Alarm::Pattern check(Reading const& v) const {
+			return inTheSafeZone(v) ? Alarm::Pattern::BAP_OK : Alarm::Pattern::BAP_LUMINOSITY;
+		}
+
+		String toString(Reading const& v) const {
+			return "Luminosity: [" + String(percent(v)) + "%]";
+		}
+
+		String toValues(Reading const& v) const {
+			return String(v);
+		}
+
+		void show(Display& display, Reading const& v, uint8 const) const {
+			display.setCursorPosition(0, 1);
+			display.write("Luminosity: ");
+			display.writeInt(percent(v), '%', 11, 1);
+		}
+
+		/// @brief Returns whether the adjustment is usable, and some luminosity is within the thresholds.
+		bool consistent() const {
+			auto const i = info.get();
+			if (!i.adjustment.valid()) return false;
+			auto const raw = compile(i);
+			return raw.min <= raw.max;
+		}
+
+		bool valid() const		{return info.valid();				}
 		uint16 address() const	{return info.address();				}
-		uint16 end() const		{return address()	+ sizeof(Info);	}
+		uint16 end() const		{return address()	+ InfoRecord::SIZE;		}
 
 	private:
+		/// @brief Highest raw ADC reading.
+		constexpr static int16 const RAW_MAX = 1023;
+
+		static int16 percent(int16 const raw, Adjustment const& adj) {
+			return constrain(100 - map(raw, adj.min, adj.max, 0, 100), 0, 100);
+		}
+
+		/// @brief Compiles the luminosity thresholds into the raw ADC domain.
+		/// @details The luminosity decreases as the raw reading increases, so the safe zone is a single range of raw readings.
+		/// Its bounds are binary-searched with the exact same conversion as `percent()`, so both domains always agree.
+		static Threshold compile(Info const& i) {
+			Threshold raw;
+			raw.min = firstAtMost(i.threshold.max, i.adjustment);
+			raw.max = firstAtMost(i.threshold.min - 1, i.adjustment) - 1;
+			return raw;
+		}
+
+		/// @brief Returns the lowest raw reading with a luminosity of at most a given percentage, or `RAW_MAX + 1` if there is none.
+		static int16 firstAtMost(int16 const pct, Adjustment const& adj) {
+			int16 lo = 0, hi = RAW_MAX + 1;
+			while (lo < hi) {
+				int16 const mid = (lo + hi) / 2;
+				if (percent(mid, adj) <= pct)	hi = mid;
+				else							lo = mid + 1;
+			}
+			return lo;
+		}
+
 		uint8 const		pin;
-		Record<Info>	info;
+		InfoRecord		info;
+		/// @brief Luminosity thresholds, in raw ADC readings.
+		Threshold		safe;
 	};
 }
 
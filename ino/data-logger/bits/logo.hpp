@@ -1,58 +1,125 @@
 #ifndef BITS_LOGO_H
 #define BITS_LOGO_H
 
+#include <avr/pgmspace.h>
+
 #include "display.hpp"
 #include "core.hpp"
 
 namespace Bits {
+	/// @brief Boot logo animation.
+	/// @details The animation is stepped one frame at a time through `update()`, so it never blocks.
 	struct Logo {
 		Display& display;
 
 		Logo(Display& display): display(display) {}
 
+		/// @brief Loads the logo's glyphs into the display.
 		void begin() {
-			display.addCharacter(image01);
-			display.addCharacter(image02);
-			display.addCharacter(image03);
-			display.addCharacter(image17);
-			display.addCharacter(image19);
-			display.addCharacter(image18);
+			for (auto const& glyph: GLYPHS)
+				display.addCharacter(&glyph);
 		}
 
+		/// @brief Starts the animation.
 		void animate() {
-			display.clear();
-			display.setCursorPosition(2, 0);
-			display.write("\x01\x02\x03");
-			display.write("CHRONO");
-			display.setCursorPosition(2, 1);
-			display.write("\x04\x06\x05");
-			display.setCursorPosition(11, 0);
-			display.write("\x01\x02\x03");
-			display.setCursorPosition(11, 1);
-			display.write("\x04\x06\x05");
-			for (usize i = 0; i < 16; ++i)
-				display.scroll(Display::TextDirection::BDTD_LEFT);
-			for (usize i = 0; i < 16; ++i) {
-				display.scroll(Display::TextDirection::BDTD_RIGHT);
-				Wait::seconds(0.15);
-			}
-			Wait::seconds(2.9);
-			for (usize i = 0; i < 16; ++i) {
-				display.scroll(Display::TextDirection::BDTD_RIGHT);
-				Wait::seconds(0.15);
+			stage		= Stage::BLS_BLANK;
+			frame		= 0;
+			nextFrame	= millis();
+		}
+
+		/// @brief Steps the animation, if its next frame is due.
+		/// @return Whether the animation is still running.
+		bool update() {
+			if (!running()) return false;
+			if (static_cast<int32>(millis() - nextFrame) < 0) return true;
+			switch (stage) {
+				case Stage::BLS_BLANK: {
+					display.setDisplay(Display::State::BDS_OFF);
+					next(Stage::BLS_DRAW, 1000);
+				} break;
+				case Stage::BLS_DRAW: {
+					display.setDisplay(Display::State::BDS_ON);
+					display.clear();
+					display.setCursorPosition(2, 0);
+					display.write("\x01\x02\x03");
+					display.write("CHRONO");
+					display.setCursorPosition(2, 1);
+					display.write("\x04\x06\x05");
+					display.setCursorPosition(11, 0);
+					display.write("\x01\x02\x03");
+					display.setCursorPosition(11, 1);
+					display.write("\x04\x06\x05");
+					for (usize i = 0; i < 16; ++i)
+						display.scroll(Display::TextDirection::BDTD_LEFT);
+					next(Stage::BLS_SCROLL_IN, 0);
+				} break;
+				case Stage::BLS_SCROLL_IN: {
+					display.scroll(Display::TextDirection::BDTD_RIGHT);
+					if (++frame < 16) nextFrame += 150;
+					else next(Stage::BLS_SCROLL_OUT, 150 + 2900);
+				} break;
+				case Stage::BLS_SCROLL_OUT: {
+					display.scroll(Display::TextDirection::BDTD_RIGHT);
+					if (++frame < 16) nextFrame += 150;
+					else next(Stage::BLS_CLEAR, 150);
+				} break;
+				case Stage::BLS_CLEAR: {
+					display.clear();
+					next(Stage::BLS_DONE, 900);
+				} break;
+				case Stage::BLS_DONE: {
+					stage = Stage::BLS_IDLE;
+				} break;
+				default: break;
 			}
-			display.clear();
-			Wait::seconds(0.9);
+			return running();
+		}
+
+		/// @brief Stops the animation.
+		void skip() {
+			stage = Stage::BLS_IDLE;
 		}
 
+		/// @brief Returns whether the animation is running.
+		bool running() const {return stage != Stage::BLS_IDLE;}
+
+		/// @brief Returns when the next frame is due (as in `millis()`).
+		uint32 deadline() const {return nextFrame;}
+
 	private:
-		Display::Character const image01 = {1, {B11111, B11111, B01110, B01110, B01101, B01101, B01100, B01100}};
-		Display::Character const image02 = {2, {B11111, B11111, B00000, B11111, B00000, B11111, B10001, B01110}};
-		Display::Character const image03 = {3, {B11111, B11111, B01110, B01110, B10110, B10110, B00110, B00110}};
-		Display::Character const image17 = {4, {B01100, B01100, B01101, B01101, B01110, B01110, B11111, B11111}};
-		Display::Character const image19 = {5, {B00110, B00110, B10110, B10110, B01110, B01110, B11111, B11111}};
-		Display::Character const image18 = {6, {B01110, B10001, B11111, B00000, B11111, B00000, B11111, B11111}};
+		/// @brief Animation stage.
+		enum class Stage: uint8 {
+			BLS_IDLE,
+			BLS_BLANK,
+			BLS_DRAW,
+			BLS_SCROLL_IN,
+			BLS_SCROLL_OUT,
+			BLS_CLEAR,
+			BLS_DONE,
+		};
+
+		/// @brief Moves on to the next stage.
+		/// @param next Stage to move to.
+		/// @param delay Time to wait before it, in milliseconds.
+		void next(Stage const next, uint16 const delay) {
+			stage		= next;
+			frame		= 0;
+			nextFrame	+= delay;
+		}
+
+		constexpr static Display::Character const GLYPHS[] PROGMEM = {
+			{1, {B11111, B11111, B01110, B01110, B01101, B01101, B01100, B01100}},
+			{2, {B11111, B11111, B00000, B11111, B00000, B11111, B10001, B01110}},
+			{3, {B11111, B11111, B01110, B01110, B10110, B10110, B00110, B00110}},
+			{4, {B01100, B01100, B01101, B01101, B01110, B01110, B11111, B11111}},
+			{5, {B00110, B00110, B10110, B10110, B01110, B01110, B11111, B11111}},
+			{6, {B01110, B10001, B11111, B00000, B11111, B00000, B11111, B11111}},
+		};
+
+		Stage	stage		= Stage::BLS_IDLE;
+		uint8	frame		= 0;
+		uint32	nextFrame	= 0;
 	};
 }
 
-#endif
\ No newline at end of file
+#endif
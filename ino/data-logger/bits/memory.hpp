@@ -0,0 +1,110 @@
+#ifndef BITS_MEMORY_H
+#define BITS_MEMORY_H
+
+#include "types.hpp"
+
+/// @brief Linker & allocator symbols.
+extern "C" {
+	/// @brief Start of the static data.
+	extern uint8 __data_start;
+	/// @brief Start of the heap, right after the static data.
+	extern uint8 __heap_start;
+	/// @brief Top of the heap, or `nullptr` if nothing was ever allocated.
+	extern uint8* __brkval;
+
+	/// @brief Allocator free list node.
+	struct __freelist {
+		size_t		sz;
+		__freelist*	nx;
+	};
+
+	/// @brief Allocator free list.
+	extern __freelist* __flp;
+}
+
+/// @brief Helper classes & functions.
+namespace Bits {
+	/// @brief SRAM accounting.
+	/// @details The gap between the heap and the stack is painted with `CANARY` at boot.
+	/// The stack overwrites it as it grows, so the lowest overwritten byte marks the deepest the stack ever got.
+	namespace Memory {
+		/// @brief Byte the free memory is painted with at boot.
+		constexpr uint8 const CANARY = 0xC5;
+
+		namespace {
+			/// @brief Highest heap top seen so far.
+			static uint8* heapPeak = &__heap_start;
+
+			/// @brief Paints the free memory, before anything else runs. `.noinit` data lies below the heap, and is left alone.
+			[[gnu::naked, gnu::used, gnu::section(".init3")]]
+			static void paint() {
+				for (uint8* p = &__heap_start; p < reinterpret_cast<uint8*>(SP); ++p)
+					*p = CANARY;
+			}
+		}
+
+		/// @brief Returns the current top of the heap.
+		inline uint8* heapTop() {
+			return __brkval ? __brkval : &__heap_start;
+		}
+
+		/// @brief Records the heap top. Should be called regularly, since the heap also shrinks.
+		inline void track() {
+			if (heapTop() > heapPeak)
+				heapPeak = heapTop();
+		}
+
+		/// @brief Returns the size of the static data (`.data`, `.bss` and `.noinit`), in bytes.
+		inline uint16 data() {
+			return &__heap_start - &__data_start;
+		}
+
+		/// @brief Returns the memory between the heap and the stack, in bytes.
+		inline uint16 available() {
+			uint8* const sp = reinterpret_cast<uint8*>(SP);
+			return sp > heapTop() ? sp - heapTop() : 0;
+		}
+
+		/// @brief Returns the memory taken up by the heap, in bytes, free blocks included.
+		inline uint16 heapSize() {
+			return heapTop() - &__heap_start;
+		}
+
+		/// @brief Returns the largest the heap has been seen, in bytes.
+		inline uint16 heapMax() {
+			track();
+			return heapPeak - &__heap_start;
+		}
+
+		/// @brief Returns the memory held by the allocator's free blocks, in bytes.
+		inline uint16 heapFree() {
+			uint16 total = 0;
+			for (__freelist* block = __flp; block; block = block->nx)
+				total += block->sz + sizeof(size_t);
+			return total;
+		}
+
+		/// @brief Returns the lowest byte the stack ever overwrote.
+		/// @details Scans up from the highest heap top seen, since the heap may have overwritten the paint below it.
+		inline uint8 const* watermark() {
+			track();
+			uint8 const* p = heapPeak;
+			while (p <= reinterpret_cast<uint8 const*>(RAMEND) && *p == CANARY) ++p;
+			return p;
+		}
+
+		/// @brief Returns the deepest the stack ever got, in bytes.
+		/// @note An upper bound: a heap peak between two `track()` calls may have overwritten paint above the recorded peak,
+		/// which then counts as stack.
+		inline uint16 stackMax() {
+			return reinterpret_cast<uint8 const*>(RAMEND) + 1 - watermark();
+		}
+
+		/// @brief Returns the memory neither the heap nor the stack ever reached, in bytes.
+		inline uint16 untouched() {
+			return watermark() - heapPeak;
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef BITS_OUTPUT_H
+#define BITS_OUTPUT_H
+
+#include "types.hpp"
+#include "watchdog.hpp"
+
+#ifndef BITS_TX_BUFFER_SIZE
+/// @brief Size, in bytes, of the serial output queue (on top of the core's own TX buffer).
+#define BITS_TX_BUFFER_SIZE 128
+#endif
+
+/// @brief Helper classes & functions.
+namespace Bits {
+	/// @brief Buffered serial output queue.
+	/// @details Printing only queues bytes. `pump()` moves them into the serial TX buffer, as far as it can without blocking.
+	/// Long outputs should check `room()` before producing their next chunk, instead of filling the queue up.
+	/// @note If the queue does fill up, printing falls back to waiting for it to drain, so nothing is ever lost.
+	/// @tparam SIZE Queue size, in bytes.
+	template <uint16 SIZE = BITS_TX_BUFFER_SIZE>
+	struct Output: Print {
+		static_assert(SIZE > 1);
+
+		/// @brief Queues a byte.
+		/// @param c Byte to queue.
+		/// @return Bytes queued.
+		size_t write(uint8 const c) override {
+			while (full()) {
+				pump();
+				Watchdog::keepAlive();
+			}
+			buffer[tail] = c;
+			tail = next(tail);
+			return 1;
+		}
+
+		using Print::write;
+
+		/// @brief Prints a value as fixed-width, zero-padded hexadecimal.
+		/// @param value Value to print.
+		/// @param digits Amount of digits to print.
+		void printHex(uint16 const value, uint8 const digits) {
+			for (uint8 i = digits; i--;) {
+				uint8 const nibble = (value >> (i * 4)) & 0xF;
+				write(nibble < 10 ? '0' + nibble : 'A' + nibble - 10);
+			}
+		}
+
+		/// @brief Moves queued bytes into the serial TX buffer, until either is empty or full. Never blocks.
+		void pump() {
+			while (!empty() && Serial.availableForWrite() > 0) {
+				Serial.write(buffer[head]);
+				head = next(head);
+			}
+		}
+
+		/// @brief Waits until every queued byte has been handed over to the serial interface.
+		void drain() {
+			while (!empty()) {
+				pump();
+				Watchdog::keepAlive();
+			}
+		}
+
+		/// @brief Returns the amount of bytes that can be queued without waiting.
+		uint16 room() const		{return (SIZE - 1) - used();					}
+		/// @brief Returns the amount of queued bytes.
+		uint16 used() const		{return (tail + SIZE - head) % SIZE;			}
+		/// @brief Returns whether the queue is empty.
+		bool empty() const		{return head == tail;							}
+		/// @brief Returns whether the queue is full.
+		bool full() const		{return next(tail) == head;						}
+
+	private:
+		constexpr static uint16 next(uint16 const i) {return (i + 1 < SIZE) ? i + 1 : 0;}
+
+		/// @brief Queued bytes.
+		uint8				buffer[SIZE];
+		/// @brief Next byte to send.
+		volatile uint16		head	= 0;
+		/// @brief Next free byte.
+		volatile uint16		tail	= 0;
+	};
+}
+
+#endif
@@ -5,21 +5,45 @@
 #include "clock.hpp"
 #include "sensor.hpp"
 #include "ldr.hpp"
+#include "core.hpp"
+#include "units.hpp"
+#include "watchdog.hpp"
+#include "channels.hpp"
 
 /// @brief Helper classes & functions.
 namespace Bits {
+	/// @brief Configuration transaction state.
+	/// @details While a transaction is open, configuration changes are only staged in RAM, and nothing is committed to the EEPROM.
+	struct Transaction {
+		/// @brief Whether a transaction is open.
+		bool	active	= false;
+		/// @brief Whether a date & time change is staged.
+		bool	dated	= false;
+		/// @brief Staged date & time, as a UNIX timestamp.
+		uint32	date	= 0;
+		/// @brief Amount of staged changes.
+		uint8	changes	= 0;
+	};
+
 	/// @brief Serial interface parser.
 	/// @tparam T Data bank entry type.
-	template <class T>
+	/// @tparam MAX Data bank entry limit.
+	/// @tparam C Sensor channel list.
+	/// @note Channel-specific arguments take an optional channel number, counted per channel type (e.g. `temp:1` for the second sensor).
+	template <class T, uint16 MAX = 64, class C = Channels<BasicSensor<>, LDR>>
 	struct Parser {
 		/// @brief Data bank.
-		DataBank<T>&	db;
+		DataBank<T, MAX>&	db;
 		/// @brief Clock.
 		Clock&			clock;
-		/// @brief Sensor.
-		Sensor&			sensor;
-		/// @brief LDR.
-		LDR&			ldr;
+		/// @brief Sensor channels.
+		C&				channels;
+		/// @brief Watchdog service.
+		Watchdog&		watchdog;
+		/// @brief Configuration transaction.
+		Transaction&	transaction;
+		/// @brief Output stream.
+		Print&			out;
 		
 		/// @brief Response.
 		struct Response {
@@ -35,19 +59,80 @@ namespace Bits {
 				BPRT_INVALID_VALUE
 			};
 			
+			/// @brief Action the caller must carry out (or render) for a successful command.
+			enum class Action: uint8 {
+				BPRA_NONE,
+				/// @brief Save everything and reset.
+				BPRA_RESET,
+				BPRA_CLOCK_SET,
+				BPRA_TEMPERATURE_SET,
+				BPRA_HUMIDITY_SET,
+				BPRA_LUMINOSITY_SET,
+				BPRA_CALIBRATION_SET,
+				BPRA_UNIT_SET,
+				/// @brief Report the latest channel readings.
+				BPRA_READ_SENSORS,
+				/// @brief Report a raw LDR reading. Value: raw reading.
+				BPRA_RAW_LDR,
+				/// @brief Change the baud rate. Value: index into `Baud::RATES`.
+				BPRA_BAUD,
+				/// @brief Set the sleep mode. Value: whether to use deep sleep.
+				BPRA_SLEEP,
+				/// @brief Acknowledge the alarm.
+				BPRA_ALARM_ACK,
+				/// @brief Silence (or unsilence) the alarm. Value: whether to silence it.
+				BPRA_ALARM_SILENCE,
+				/// @brief Set the boot logo. Value: whether to skip it.
+				BPRA_LOGO,
+				BPRA_BEGIN,
+				BPRA_COMMIT,
+				BPRA_ABORT,
+				/// @brief Set the response mode. Value: whether to use machine mode.
+				BPRA_MODE,
+				/// @brief List the log entries, with `printLogEntry`, then close the listing with `printLogFooter`.
+				BPRA_VIEW_LOG,
+				/// @brief Wipe the whole EEPROM, then reset.
+				BPRA_WIPE,
+				/// @brief Empty the log, dropping whatever is still staged.
+				BPRA_WIPE_LOG,
+				/// @brief Start (or stop) streaming readings. Value: period in milliseconds (`0` to stop) in the low half, field mask in the high half.
+				BPRA_STREAM,
+				/// @brief Report memory usage.
+				BPRA_STATS_MEMORY,
+			};
+			
 			/// @brief Response type.
 			Type	type	= Type::BPRT_OK;
-			/// @brief Response ID.
-			uint32	id		= 0;
+			/// @brief Action to carry out.
+			Action	action	= Action::BPRA_NONE;
+			/// @brief Action payload.
+			int32	value	= 0;
 
 			/// @brief Empty constructor.
 			constexpr Response() {}
 
 			/// @brief Other constructors.	
-			constexpr Response(Type const type):					type(type)			{}
-			constexpr Response(uint8 const id):						id(id)				{}
-			constexpr Response(Type const type, uint8 const id):	type(type), id(id)	{}
-			constexpr Response(uint8 const id, Type const type):	type(type), id(id)	{}
+			constexpr Response(Type const type):						type(type)					{}
+			constexpr Response(Action const action, int32 const value = 0):	action(action), value(value)	{}
+
+			/// @brief Returns whether the action changes the configuration, i.e. is staged inside a transaction.
+			constexpr bool configures() const {
+				switch (action) {
+					case Action::BPRA_CLOCK_SET:
+					case Action::BPRA_TEMPERATURE_SET:
+					case Action::BPRA_HUMIDITY_SET:
+					case Action::BPRA_LUMINOSITY_SET:
+					case Action::BPRA_CALIBRATION_SET:
+					case Action::BPRA_UNIT_SET:
+					case Action::BPRA_BAUD:
+					case Action::BPRA_SLEEP:
+					case Action::BPRA_LOGO:
+					case Action::BPRA_MODE:
+						return true;
+					default:
+						return false;
+				}
+			}
 		};
 
 		/// @brief Evaluates a command string.
@@ -61,12 +146,16 @@ namespace Bits {
 				command == "@set"
 			||	command == "@s"
 			) {
-				String const param = arg(str, 1);
+				String const target = arg(str, 1);
+				String const param = arg(target, 0, ':');
+				uint8 const index = arg(target, 1, ':').toInt();
 				if (!param.length()) return {Response::Type::BPRT_MISSING_ARGUMENT};
 				if (
 					param == "temp"
 				||	param == "t"
 				) {
+					auto const sensor = channels.template find<Sensor>(index);
+					if (!sensor) return {Response::Type::BPRT_INVALID_ARGUMENT};
 					String const min	= arg(str, 2);
 					String const max	= arg(str, 3);
 					String const unit	= arg(str, 4);
@@ -74,9 +163,13 @@ namespace Bits {
 						!min.length()
 					||	!max.length()
 					) return {Response::Type::BPRT_MISSING_VALUE};
-					auto const minVal = min.toFloat(), maxVal = max.toFloat();
-					if (maxVal <= minVal) return {Response::Type::BPRT_INVALID_VALUE};
-					auto v = sensor.getThreshold();
+					auto const minVal = Units::parse(min.c_str()), maxVal = Units::parse(max.c_str());
+					if (
+						minVal == Units::INVALID
+					||	maxVal == Units::INVALID
+					||	maxVal <= minVal
+					) return {Response::Type::BPRT_INVALID_VALUE};
+					auto v = sensor->getThreshold();
 					Bits::Sensor::Unit base;
 					if (
 						!unit.length()
@@ -88,14 +181,16 @@ namespace Bits {
 					else if (
 						unit == "k"
 					) base = Bits::Sensor::Unit::BSU_KELVIN;
-					v.min.temperature = sensor.toCelcius(minVal * 100, base);
-					v.max.temperature = sensor.toCelcius(maxVal * 100, base);
-					sensor.setThreshold(v);
-					return {2};
+					v.min.temperature = Sensor::toCelcius(minVal, base);
+					v.max.temperature = Sensor::toCelcius(maxVal, base);
+					sensor->setThreshold(v);
+					return {Response::Action::BPRA_TEMPERATURE_SET};
 				} else if (
 					param == "unit"
 				||	param == "u"
 				) {
+					auto const sensor = channels.template find<Sensor>(index);
+					if (!sensor) return {Response::Type::BPRT_INVALID_ARGUMENT};
 					String const unit	= arg(str, 2);
 					if (!unit.length())
 						return {Response::Type::BPRT_MISSING_VALUE};
@@ -111,24 +206,31 @@ namespace Bits {
 						unit == "k"
 					) base = Bits::Sensor::Unit::BSU_KELVIN;
 					else return {Response::Type::BPRT_INVALID_VALUE};
-					sensor.setUnit(base);
+					sensor->setUnit(base);
+					return {Response::Action::BPRA_UNIT_SET};
 				} else if (
 					param == "hum"
 				||	param == "h"
 				) {
+					auto const sensor = channels.template find<Sensor>(index);
+					if (!sensor) return {Response::Type::BPRT_INVALID_ARGUMENT};
 					String const min = arg(str, 2);
 					String const max = arg(str, 3);
 					if (
 						!min.length()
 					||	!max.length()
 					) return {Response::Type::BPRT_MISSING_VALUE};
-					auto const minVal = min.toFloat(), maxVal = max.toFloat();
-					if (maxVal <= minVal) return {Response::Type::BPRT_INVALID_VALUE};
-					auto v = sensor.getThreshold();
-					v.min.humidity = minVal * 100;
-					v.max.humidity = maxVal * 100;
-					sensor.setThreshold(v);
-					return {3};
+					auto const minVal = Units::parse(min.c_str()), maxVal = Units::parse(max.c_str());
+					if (
+						minVal == Units::INVALID
+					||	maxVal == Units::INVALID
+					||	maxVal <= minVal
+					) return {Response::Type::BPRT_INVALID_VALUE};
+					auto v = sensor->getThreshold();
+					v.min.humidity = Units::saturate(minVal);
+					v.max.humidity = Units::saturate(maxVal);
+					sensor->setThreshold(v);
+					return {Response::Action::BPRA_HUMIDITY_SET};
 				} else if (
 					param == "dt"
 				||	param == "d"
@@ -138,7 +240,10 @@ namespace Bits {
 						return {Response::Type::BPRT_MISSING_VALUE};
 					auto const date = DateTime(dt.c_str());
 					if (!date.isValid()) return {Response::Type::BPRT_INVALID_VALUE};
-					clock.adjust(date);
+					if (transaction.active) {
+						transaction.date	= date.unixtime();
+						transaction.dated	= true;
+					} else clock.adjust(date);
 				} else if (
 					param == "zone"
 				||	param == "z"
@@ -153,11 +258,13 @@ namespace Bits {
 					) return {Response::Type::BPRT_MISSING_VALUE};
 					int8 const z = (hour.toInt() * 4) + minute.toInt() / 15;
 					clock.setTimeZone(z);
-					return {1};
+					return {Response::Action::BPRA_CLOCK_SET};
 				} else if (
 					param == "ldr"
 				||	param == "l"
 				) {
+					auto const ldr = channels.template find<LDR>(index);
+					if (!ldr) return {Response::Type::BPRT_INVALID_ARGUMENT};
 					String const min = arg(str, 2);
 					String const max = arg(str, 3);
 					if (
@@ -166,16 +273,18 @@ namespace Bits {
 					) return {Response::Type::BPRT_MISSING_VALUE};
 					auto const minVal = min.toInt(), maxVal = max.toInt();
 					if (maxVal <= minVal) return {Response::Type::BPRT_INVALID_VALUE};
-					auto v = ldr.getThreshold();
+					auto v = ldr->getThreshold();
 					v.min = minVal;
 					v.max = maxVal;
-					ldr.setThreshold(v);
-					return {4};
+					ldr->setThreshold(v);
+					return {Response::Action::BPRA_LUMINOSITY_SET};
 				} else if (
 					param == "radj"
 				||	param == "ra"
 				||	param == "a"
 				) {
+					auto const ldr = channels.template find<LDR>(index);
+					if (!ldr) return {Response::Type::BPRT_INVALID_ARGUMENT};
 					String const min = arg(str, 2);
 					String const max = arg(str, 3);
 					if (
@@ -184,45 +293,79 @@ namespace Bits {
 					) return {Response::Type::BPRT_MISSING_VALUE};
 					auto const minVal = min.toInt(), maxVal = max.toInt();
 					if (maxVal <= minVal) return {Response::Type::BPRT_INVALID_VALUE};
-					auto v = ldr.getAdjustment();
+					auto v = ldr->getAdjustment();
 					v.min = minVal;
 					v.max = maxVal;
-					ldr.setAdjustment(v);
-					return {5};
+					ldr->setAdjustment(v);
+					return {Response::Action::BPRA_CALIBRATION_SET};
+				} else if (
+					param == "baud"
+				||	param == "b"
+				) {
+					String const rate = arg(str, 2);
+					if (!rate.length())
+						return {Response::Type::BPRT_MISSING_VALUE};
+					uint8 const index = Baud::index(rate.toInt());
+					if (index >= Baud::COUNT) return {Response::Type::BPRT_INVALID_VALUE};
+					return {Response::Action::BPRA_BAUD, index};
+				} else if (
+					param == "sleep"
+				||	param == "sl"
+				) {
+					String const mode = arg(str, 2);
+					if (!mode.length())
+						return {Response::Type::BPRT_MISSING_VALUE};
+					if (mode == "idle")			return {Response::Action::BPRA_SLEEP, false};
+					else if (mode == "deep")	return {Response::Action::BPRA_SLEEP, true};
+					else return {Response::Type::BPRT_INVALID_VALUE};
+				} else if (
+					param == "logo"
+				||	param == "lg"
+				) {
+					String const state = arg(str, 2);
+					if (!state.length())
+						return {Response::Type::BPRT_MISSING_VALUE};
+					if (state == "on")			return {Response::Action::BPRA_LOGO, false};
+					else if (state == "off")	return {Response::Action::BPRA_LOGO, true};
+					else return {Response::Type::BPRT_INVALID_VALUE};
 				} else return {Response::Type::BPRT_INVALID_ARGUMENT};
 			}  else if (
 				command == "@view"
 			||	command == "@v"
 			) {
-				String const param = arg(str, 1);
+				String const target = arg(str, 1);
+				String const param = arg(target, 0, ':');
+				uint8 const index = arg(target, 1, ':').toInt();
 				if (!param.length()) return {Response::Type::BPRT_MISSING_ARGUMENT};
 				if (
 					param == "log"
 				||	param == "l"
 				) {
-					Serial.println("");
-					Serial.println("*-------------------*");
-					Serial.println("*-       LOG       -*");
-					Serial.println("*-------------------*");
-					Serial.println("");
+					out.println(F(""));
+					out.println(F("*-------------------*"));
+					out.println(F("*-       LOG       -*"));
+					out.println(F("*-------------------*"));
+					out.println(F(""));
 					if (db.empty())
-						Serial.println("No anomalies detected.");
+						out.println(F("No anomalies detected."));
 					else {
-						Serial.print("Total anomalies registered: ");
-						Serial.println(db.size());
-						Serial.println("");
-						for (usize i = 0; i < db.size(); ++i)
-							Serial.println(db[i].toString(sensor));
+						out.print(F("Total anomalies registered: "));
+						out.println(db.size());
+						out.println(F(""));
 					}
-					Serial.println("");
-					Serial.println("*-------------------*");
-					Serial.println("");
+					return {Response::Action::BPRA_VIEW_LOG};
 				} else if (
 					param == "thresh"
 				||	param == "t"
 				) {
-					printSensorThresholds();
-					printLDRThresholds();
+					channels.forEach([this] (auto const& channel, uint8 const index) {
+						if (C::COUNT > 1) {
+							out.print(F("Channel "));
+							out.print(index);
+							out.println(F(":"));
+						}
+						printThresholds(channel);
+					});
 				} else if (
 						param == "zone"
 				||	param == "z"
@@ -233,7 +376,14 @@ namespace Bits {
 				||	param == "ra"
 				||	param == "a"
 				) {
-					printLDRAdjustment();
+					auto const ldr = channels.template find<LDR>(index);
+					if (!ldr) return {Response::Type::BPRT_INVALID_ARGUMENT};
+					printLDRAdjustment(*ldr);
+				} else if (
+					param == "crash"
+				||	param == "c"
+				) {
+					printCrash();
 				} else return {Response::Type::BPRT_INVALID_ARGUMENT};
 			} else if (
 				command == "@wipe"
@@ -241,77 +391,203 @@ namespace Bits {
 			) {
 				String const param = arg(str, 1);
 				if (!param.length()) return {Response::Type::BPRT_MISSING_ARGUMENT};
-				if (param == "absolutelyeverything") {
-					for (usize i = 0; i < EEPROM.length(); ++i)
-						EEPROM[i] = 0;
-					return {-1};
-				} else if (param == "log")
-					db.clear();
+				if (param == "absolutelyeverything")
+					return {Response::Action::BPRA_WIPE};
+				else if (param == "log")
+					return {Response::Action::BPRA_WIPE_LOG};
 				else return {Response::Type::BPRT_INVALID_ARGUMENT};
-			} else if (command == "@reset") return {-1};
+			} else if (
+				command == "@alarm"
+			||	command == "@a"
+			) {
+				String const param = arg(str, 1);
+				if (!param.length()) return {Response::Type::BPRT_MISSING_ARGUMENT};
+				if (
+					param == "ack"
+				||	param == "a"
+				) return {Response::Action::BPRA_ALARM_ACK};
+				else if (
+					param == "silence"
+				||	param == "s"
+				) return {Response::Action::BPRA_ALARM_SILENCE, true};
+				else if (
+					param == "on"
+				||	param == "o"
+				) return {Response::Action::BPRA_ALARM_SILENCE, false};
+				else return {Response::Type::BPRT_INVALID_ARGUMENT};
+			} else if (command == "@begin") {
+				if (transaction.active) return {Response::Type::BPRT_INVALID_COMMAND};
+				return {Response::Action::BPRA_BEGIN};
+			} else if (command == "@commit") {
+				if (!transaction.active) return {Response::Type::BPRT_INVALID_COMMAND};
+				if (!channels.consistent()) return {Response::Type::BPRT_INVALID_VALUE};
+				return {Response::Action::BPRA_COMMIT};
+			} else if (command == "@abort") {
+				if (!transaction.active) return {Response::Type::BPRT_INVALID_COMMAND};
+				return {Response::Action::BPRA_ABORT};
+			} else if (command == "@mode") {
+				String const mode = arg(str, 1);
+				if (!mode.length()) return {Response::Type::BPRT_MISSING_ARGUMENT};
+				if (
+					mode == "human"
+				||	mode == "h"
+				) return {Response::Action::BPRA_MODE, false};
+				else if (
+					mode == "machine"
+				||	mode == "m"
+				) return {Response::Action::BPRA_MODE, true};
+				else return {Response::Type::BPRT_INVALID_ARGUMENT};
+			} else if (command == "@stream") {
+				String const period = arg(str, 1);
+				if (!period.length()) return {Response::Type::BPRT_MISSING_ARGUMENT};
+				if (period == "off") return {Response::Action::BPRA_STREAM, 0};
+				if (!isNumber(period)) return {Response::Type::BPRT_INVALID_ARGUMENT};
+				int32 const ms = period.toInt();
+				if (ms <= 0 || ms > 0xFFFF) return {Response::Type::BPRT_INVALID_VALUE};
+				String const fields = arg(str, 2);
+				uint16 mask = 0;
+				if (!fields.length())
+					mask = (1ul << FIELDS) - 1;
+				else for (usize i = 0; ; ++i) {
+					String const field = arg(fields, i, ',');
+					if (!field.length()) break;
+					if (!isNumber(field) || field.toInt() >= FIELDS)
+						return {Response::Type::BPRT_INVALID_VALUE};
+					mask |= 1u << field.toInt();
+				}
+				return {Response::Action::BPRA_STREAM, ms | (static_cast<int32>(mask) << 16)};
+			} else if (command == "@stats") {
+				String const param = arg(str, 1);
+				if (!param.length()) return {Response::Type::BPRT_MISSING_ARGUMENT};
+				if (
+					param == "mem"
+				||	param == "m"
+				) return {Response::Action::BPRA_STATS_MEMORY};
+				else return {Response::Type::BPRT_INVALID_ARGUMENT};
+			} else if (command == "@reset") return {Response::Action::BPRA_RESET};
 			else if (
 				command == "@read"
 			||	command == "@r"
 			) {
-				String const param = arg(str, 1);
+				String const target = arg(str, 1);
+				String const param = arg(target, 0, ':');
+				uint8 const index = arg(target, 1, ':').toInt();
 				if (
 					!param.length()
 				||	param == "sensors"
-				) return {6};
+				) return {Response::Action::BPRA_READ_SENSORS};
 				else if (
 					param == "rawldr"
-				) return {7};
+				) {
+					auto const ldr = channels.template find<LDR>(index);
+					if (!ldr) return {Response::Type::BPRT_INVALID_ARGUMENT};
+					return {Response::Action::BPRA_RAW_LDR, ldr->readRaw()};
+				}
 				else return {Response::Type::BPRT_INVALID_ARGUMENT};
 			}
 			else return {Response::Type::BPRT_INVALID_COMMAND};
 			return {};
 		}
 
+		/// @brief Prints a log entry.
+		/// @param entry Entry to print.
+		void printLogEntry(T const& entry) const {
+			out.println(entry.toString(channels));
+		}
+
+		/// @brief Closes a log listing.
+		void printLogFooter() const {
+			out.println(F(""));
+			out.println(F("*-------------------*"));
+			out.println(F(""));
+		}
+
 	private:
-		void printSensorThresholds() const {
-			Serial.print("Temperature (");
-			Serial.print(static_cast<char>(sensor.getUnit()));
-			Serial.println("):");
+		void printThresholds(Sensor const& sensor) const {
+			out.print(F("Temperature ("));
+			out.print(static_cast<char>(sensor.getUnit()));
+			out.println(F("):"));
 			auto const t = sensor.getThreshold();
 			auto const
 				min = sensor.toCurrentUnit(t.min),
 				max = sensor.toCurrentUnit(t.max)
 			; 
-			Serial.print("    MIN: ");
-			Serial.println(min.temperature / 100.0);
-			Serial.print("    MAX: ");
-			Serial.println(max.temperature / 100.0);
-			Serial.println("Humidity (%):");
-			Serial.print("    MIN: ");
-			Serial.println(min.humidity / 100.0);
-			Serial.print("    MAX: ");
-			Serial.println(max.humidity / 100.0);
+			out.print(F("    MIN: "));
+			out.println(Units::toString(min.temperature));
+			out.print(F("    MAX: "));
+			out.println(Units::toString(max.temperature));
+			out.println(F("Humidity (%):"));
+			out.print(F("    MIN: "));
+			out.println(Units::toString(min.humidity));
+			out.print(F("    MAX: "));
+			out.println(Units::toString(max.humidity));
 		}
 
-		void printLDRThresholds() const {
+		void printThresholds(LDR const& ldr) const {
 			auto const t = ldr.getThreshold();
-			Serial.println("Luminosity (%):");
-			Serial.print("    MIN: ");
-			Serial.println(t.min);
-			Serial.print("    MAX: ");
-			Serial.println(t.max);
+			out.println(F("Luminosity (%):"));
+			out.print(F("    MIN: "));
+			out.println(t.min);
+			out.print(F("    MAX: "));
+			out.println(t.max);
 		}
 
-		void printLDRAdjustment() const {
+		void printLDRAdjustment(LDR const& ldr) const {
 			auto const a = ldr.getAdjustment();
-			Serial.println("Adjustment (RAW):");
-			Serial.print("    MIN: ");
-			Serial.println(a.min);
-			Serial.print("    MAX: ");
-			Serial.println(a.max);
+			out.println(F("Adjustment (RAW):"));
+			out.print(F("    MIN: "));
+			out.println(a.min);
+			out.print(F("    MAX: "));
+			out.println(a.max);
 		}
 
 		void printTimezone() const {
-			Serial.print("Timezone: ");
+			out.print(F("Timezone: "));
 			auto const z = clock.getTimeZone();
-			Serial.print(z / 4);
-			Serial.print(":");
-			Serial.println((static_cast<uint8>(z < 0 ? -z : z) % 4) * 15);
+			out.print(z / 4);
+			out.print(F(":"));
+			out.println((static_cast<uint8>(z < 0 ? -z : z) % 4) * 15);
+		}
+
+		void printCrash() const {
+			auto const c = watchdog.breadcrumb();
+			out.print(F("Abnormal resets: "));
+			out.println(c.resets);
+			if (!c.resets) return;
+			out.print(F("Last reset cause:"));
+			if (c.resetCause & _BV(WDRF))	out.print(F(" watchdog"));
+			if (c.resetCause & _BV(BORF))	out.print(F(" brown-out"));
+			if (c.resetCause & _BV(EXTRF))	out.print(F(" external"));
+			if (c.resetCause & _BV(PORF))	out.print(F(" power-on"));
+			out.println(F(""));
+			out.print(F("Stalled stage: "));
+			switch (c.stage) {
+				case Watchdog::Stage::BWS_BOOT:			out.println(F("boot"));			break;
+				case Watchdog::Stage::BWS_COMMAND:		out.println(F("command"));		break;
+				case Watchdog::Stage::BWS_RECORDS:		out.println(F("records"));		break;
+				case Watchdog::Stage::BWS_ANIMATION:	out.println(F("animation"));	break;
+				case Watchdog::Stage::BWS_SENSING:		out.println(F("sensing"));		break;
+				case Watchdog::Stage::BWS_DISPLAY:		out.println(F("display"));		break;
+				case Watchdog::Stage::BWS_SLEEP:		out.println(F("sleep"));		break;
+				default:								out.println(F("unknown"));		break;
+			}
+			out.print(F("Last loop time (ms): "));
+			out.println(c.loopTime);
+			out.print(F("Uptime at stall (ms): "));
+			out.println(c.uptime);
+		}
+
+		/// @brief Amount of `int16` fields in a reading of every channel.
+		constexpr static uint8 const FIELDS = sizeof(typename C::Reading) / sizeof(int16);
+
+		static_assert(FIELDS <= 16, "Streams select fields with a 16-bit mask!");
+
+		/// @brief Returns whether a string is a plain, unsigned decimal number.
+		static bool isNumber(String const& str) {
+			if (!str.length()) return false;
+			for (usize i = 0; i < str.length(); ++i)
+				if (str[i] < '0' || str[i] > '9') return false;
+			return true;
 		}
 
 		// https://stackoverflow.com/questions/9072320/split-string-into-string-array
@@ -0,0 +1,123 @@
+#ifndef BITS_POWER_H
+#define BITS_POWER_H
+
+#include <avr/sleep.h>
+#include <avr/power.h>
+#include <avr/wdt.h>
+
+#include "types.hpp"
+#include "watchdog.hpp"
+
+/// @brief Millisecond counter kept by the Arduino core's Timer0 overflow interrupt.
+extern "C" volatile unsigned long timer0_millis;
+
+/// @brief Helper classes & functions.
+namespace Bits {
+	/// @brief Power manager. Puts the MCU to sleep while there is nothing to do.
+	struct Power {
+		/// @brief Sleep mode.
+		enum class Mode: uint8 {
+			/// @brief Idle sleep. Woken up by any interrupt (Timer0 tick, USART...). Everything keeps running.
+			BPM_IDLE,
+			/// @brief Power-down sleep, woken up by the watchdog or by activity on the serial RX pin.
+			/// @note The byte that wakes the MCU up is lost. Only used while the serial interface and the alarm are quiet.
+			BPM_DEEP,
+		};
+
+		/// @brief Time, in milliseconds, the MCU stays out of deep sleep after serial activity.
+		constexpr static uint16 const SERIAL_AWAKE_TIME = 10000;
+
+		/// @brief Constructs the power manager.
+		/// @param watchdog Watchdog service, used as the deep sleep wake-up timer.
+		Power(Watchdog& watchdog):
+			watchdog(watchdog) {}
+
+		/// @brief Initializes the power manager.
+		void begin() {
+			power_spi_disable();
+		}
+
+		/// @brief Keeps the MCU out of deep sleep for a while, e.g. after serial activity.
+		void stayAwake() {
+			awakeSince = millis();
+		}
+
+		/// @brief Sleeps until a given deadline, or until serial input arrives.
+		/// @param deadline Time (as in `millis()`) to wake up at.
+		/// @param mode Sleep mode to use.
+		void sleepUntil(uint32 const deadline, Mode const mode) {
+			while (!Serial.available()) {
+				int32 const left = deadline - millis();
+				if (left <= 0) return;
+				if (mode == Mode::BPM_DEEP && canPowerDown() && left >= 16)
+					powerDown(left);
+				else idle();
+			}
+		}
+
+		/// @brief Sleeps in idle mode, until the next interrupt (Timer0 tick, serial TX/RX...).
+		/// @note Used while serial output is still being sent, instead of `sleepUntil`.
+		void nap() {
+			idle();
+		}
+
+	private:
+		/// @brief Watchdog sleep periods, in milliseconds, by `WDTO_*` value.
+		constexpr static uint16 const WDT_PERIODS[] = {16, 32, 64, 125, 250, 500, 1000, 2000, 4000, 8000};
+
+		/// @brief Returns whether power-down sleep would not cut off anything in progress.
+		/// @details Timer2 runs while a tone plays, and Timer1 while an alarm note is timed. Gaps between notes run off loop deadlines.
+		bool canPowerDown() const {
+			return (
+				millis() - awakeSince >= SERIAL_AWAKE_TIME
+			&&	!(TIMSK2 & _BV(OCIE2A))
+			&&	!(TIMSK1 & _BV(OCIE1A))
+			);
+		}
+
+		/// @brief Sleeps in idle mode, until the next interrupt.
+		static void idle() {
+			set_sleep_mode(SLEEP_MODE_IDLE);
+			cli();
+			if (!Serial.available()) {
+				sleep_enable();
+				sei();
+				sleep_cpu();
+				sleep_disable();
+			}
+			sei();
+		}
+
+		/// @brief Sleeps in power-down mode, for at most a given time.
+		/// @param time Maximum time to sleep for, in milliseconds.
+		void powerDown(uint32 const time) {
+			uint8 wdto = WDTO_15MS;
+			while (wdto < WDTO_8S && WDT_PERIODS[wdto + 1] <= time)
+				++wdto;
+			Serial.flush();
+			cli();
+			watchdog.beginSleep(wdto);
+			PCMSK2	|= _BV(PCINT16);
+			PCICR	|= _BV(PCIE2);
+			set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+			sleep_enable();
+			sei();
+			sleep_cpu();
+			sleep_disable();
+			cli();
+			PCMSK2 &= ~_BV(PCINT16);
+			if (watchdog.endSleep())
+				timer0_millis += WDT_PERIODS[wdto];
+			else awakeSince = timer0_millis;
+			sei();
+		}
+
+		/// @brief Watchdog service.
+		Watchdog& watchdog;
+
+		/// @brief Time of the last activity that should keep the MCU out of deep sleep.
+		uint32 awakeSince = 0;
+	};
+}
+
+#endif
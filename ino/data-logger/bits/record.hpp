@@ -1,25 +1,134 @@
 #ifndef BITS_RECORD_H
 #define BITS_RECORD_H
 
+#include <EEPROM.h>
+
 #include "types.hpp"
+#include "crc.hpp"
 
 namespace Bits {
 	enum class CacheType: uint8 {
 		BCT_NO_CACHE,
 		BCT_CACHE_SAVE_ON_SET,
 		BCT_CACHE_MANUAL_SAVE,
-		BCT_CACHE_SAVE_ON_DTOR
+		BCT_CACHE_SAVE_ON_DTOR,
+		BCT_CACHE_WRITE_BACK
 	};
 
-	template <class T, CacheType CACHE = CacheType::BCT_NO_CACHE, bool AUTOINIT = false>
+	/// @brief Power-fail-safe record storage.
+	/// @details Values are written alternately into two slots, each tagged with a schema version, a sequence number and a checksum.
+	/// The checksum is written last and acts as the slot's commit marker: if a write is interrupted, the slot fails its check
+	/// and the other slot, still holding the previous value, is used instead.
+	/// @tparam T Value type.
+	/// @tparam VERSION Value schema version.
+	template <class T, uint8 VERSION>
+	struct RecordStorage {
+		/// @brief Storage slot, as it is laid out in the EEPROM.
+		struct PACKED Slot {
+			/// @brief Stored value.
+			T		value;
+			/// @brief Schema version the value was stored with.
+			uint8	version;
+			/// @brief Write sequence number. Its lowest bit matches the slot's index.
+			uint8	sequence;
+			/// @brief Checksum of everything above.
+			uint8	crc;
+
+			/// @brief Checksum seed. Changes whenever the value's size changes.
+			constexpr static uint8 const SEED = static_cast<uint8>(sizeof(T));
+
+			/// @brief Returns the slot's checksum.
+			uint8 checksum() const {
+				return CRC::crc8(reinterpret_cast<uint8 const*>(this), offsetof(Slot, crc), SEED);
+			}
+
+			/// @brief Returns whether the slot is intact and of the current schema version.
+			/// @param index Index of the slot.
+			bool intact(uint8 const index) const {
+				return version == VERSION && (sequence & 1) == index && crc == checksum();
+			}
+		};
+
+		/// @brief Total storage size.
+		constexpr static usize const SIZE = 2 * sizeof(Slot);
+
+		/// @brief Constructs the storage.
+		/// @param address EEPROM address of the storage.
+		RecordStorage(uint16 const address):
+			memaddr(address) {}
+
+		/// @brief Loads the newest intact value from the EEPROM.
+		/// @param out Where to store the loaded value.
+		/// @return Whether any intact value was found.
+		bool load(T& out) {
+			Slot even, odd;
+			EEPROM.get(slotAddress(0), even);
+			EEPROM.get(slotAddress(1), odd);
+			bool const
+				evenOK	= even.intact(0),
+				oddOK	= odd.intact(1)
+			;
+			if (!evenOK && !oddOK) return false;
+			Slot const& newest = (
+				(evenOK && oddOK)
+			?	((static_cast<int8>(odd.sequence - even.sequence) > 0) ? odd : even)
+			:	(oddOK ? odd : even)
+			);
+			sequence	= newest.sequence;
+			out			= newest.value;
+			return true;
+		}
+
+		/// @brief Stores a value in the EEPROM, in the slot not holding the current value.
+		/// @param value Value to store.
+		void store(T const& value) {
+			EEPROM.put(valueAddress(), prepare(value));
+		}
+
+		/// @brief Prepares a value for storing, without writing anything. The slot must then be written at `valueAddress()`.
+		/// @param value Value to store.
+		/// @return Slot to write.
+		Slot prepare(T const& value) {
+			Slot s{value, VERSION, ++sequence, 0};
+			s.crc = s.checksum();
+			return s;
+		}
+
+		/// @brief Returns the EEPROM address of the current value.
+		constexpr uint16 valueAddress() const	{return slotAddress(sequence & 1);	}
+		/// @brief Returns the EEPROM address of the storage.
+		constexpr uint16 address() const		{return memaddr;					}
+
+	private:
+		/// @brief Returns the EEPROM address of a slot.
+		/// @param index Slot index.
+		constexpr uint16 slotAddress(uint8 const index) const {
+			return memaddr + index * sizeof(Slot);
+		}
+
+		/// @brief EEPROM address.
+		uint16 const	memaddr;
+		/// @brief Sequence number of the current value.
+		uint8			sequence = 0;
+	};
+
+	template <class T, CacheType CACHE = CacheType::BCT_NO_CACHE, bool AUTOINIT = false, uint8 VERSION = 1>
 	struct Record;
 
-	template <class T, bool AUTOINIT>
-	struct Record<T, CacheType::BCT_NO_CACHE, AUTOINIT> {
+	template <class T, bool AUTOINIT, uint8 VERSION>
+	struct Record<T, CacheType::BCT_NO_CACHE, AUTOINIT, VERSION> {
+		using Storage = RecordStorage<T, VERSION>;
+
+		constexpr static usize const SIZE = Storage::SIZE;
+
 		Record(uint16 const address):
-			memaddr(address) {}
+			storage(address) {}
 
-		void begin() {}
+		void begin() {
+			T val;
+			if (!(intact = storage.load(val)))
+				set(T{});
+		}
 
 		T get() const {
 			T val;
@@ -27,27 +136,39 @@ namespace Bits {
 			return val;
 		}
 
-		void fetch(T& out) const	{EEPROM.get(memaddr, out);					}
+		void fetch(T& out) const	{EEPROM.get(storage.valueAddress(), out);	}
 
-		Record& set(T const& val)	{EEPROM.put(memaddr, val); return *this;	}
+		Record& set(T const& val)	{storage.store(val); return *this;			}
 
 		void save()					{}
 
 		inline operator T() const				{return get();		}
 		inline Record& operator=(T const& val)	{return set(val);	}
 
-		constexpr uint16 address() const {return memaddr;}
+		constexpr uint16 address() const {return storage.address();}
+
+		bool valid() const {return intact;}
 
 	private:
-		uint16 const memaddr;
+		Storage storage;
+		bool intact = true;
 	};
 
-	template <class T, bool AUTOINIT>
-	struct Record<T, CacheType::BCT_CACHE_SAVE_ON_SET, AUTOINIT> {
+	template <class T, bool AUTOINIT, uint8 VERSION>
+	struct Record<T, CacheType::BCT_CACHE_SAVE_ON_SET, AUTOINIT, VERSION> {
+		using Storage = RecordStorage<T, VERSION>;
+
+		constexpr static usize const SIZE = Storage::SIZE;
+
 		Record(uint16 const address):
-			memaddr(address) {if (AUTOINIT) begin();}
+			storage(address) {if (AUTOINIT) begin();}
 
-		void begin() {EEPROM.get(memaddr, val);}
+		void begin() {
+			if (!(intact = storage.load(val))) {
+				val = T{};
+				save();
+			}
+		}
 
 		T get() const {
 			return val;
@@ -63,24 +184,36 @@ namespace Bits {
 			return *this;
 		}
 
-		void save() {EEPROM.put(memaddr, val);}
+		void save() {storage.store(val);}
 
 		inline operator T() const				{return get();		}
 		inline Record& operator=(T const& val)	{return set(val);	}
 
-		constexpr uint16 address() const {return memaddr;}
+		constexpr uint16 address() const {return storage.address();}
+
+		bool valid() const {return intact;}
 
 	private:
-		uint16 const memaddr;
+		Storage storage;
 		T val;
+		bool intact = true;
 	};
 
-	template <class T, bool AUTOINIT>
-	struct Record<T, CacheType::BCT_CACHE_MANUAL_SAVE, AUTOINIT> {
+	template <class T, bool AUTOINIT, uint8 VERSION>
+	struct Record<T, CacheType::BCT_CACHE_MANUAL_SAVE, AUTOINIT, VERSION> {
+		using Storage = RecordStorage<T, VERSION>;
+
+		constexpr static usize const SIZE = Storage::SIZE;
+
 		Record(uint16 const address):
-			memaddr(address) {if (AUTOINIT) begin();}
+			storage(address) {if (AUTOINIT) begin();}
 
-		void begin() {EEPROM.get(memaddr, val);}
+		void begin() {
+			if (!(intact = storage.load(val))) {
+				val = T{};
+				save();
+			}
+		}
 
 		T get() const {
 			return val;
@@ -95,26 +228,38 @@ namespace Bits {
 			 return *this;
 		}
 
-		void save() {EEPROM.put(memaddr, val);}
+		void save() {storage.store(val);}
 
 		inline operator T() const				{return get();		}
 		inline Record& operator=(T const& val)	{return set(val);	}
 
-		constexpr uint16 address() const {return memaddr;}
+		constexpr uint16 address() const {return storage.address();}
+
+		bool valid() const {return intact;}
 
 	private:
-		uint16 const memaddr;
+		Storage storage;
 		T val;
+		bool intact = true;
 	};
 
-	template <class T, bool AUTOINIT>
-	struct Record<T, CacheType::BCT_CACHE_SAVE_ON_DTOR, AUTOINIT> {
+	template <class T, bool AUTOINIT, uint8 VERSION>
+	struct Record<T, CacheType::BCT_CACHE_SAVE_ON_DTOR, AUTOINIT, VERSION> {
+		using Storage = RecordStorage<T, VERSION>;
+
+		constexpr static usize const SIZE = Storage::SIZE;
+
 		Record(uint16 const address):
-			memaddr(address) {if (AUTOINIT) begin();}
+			storage(address) {if (AUTOINIT) begin();}
 
 		~Record() {save();}
 
-		void begin() {EEPROM.get(memaddr, val);}
+		void begin() {
+			if (!(intact = storage.load(val))) {
+				val = T{};
+				save();
+			}
+		}
 
 		T get() const {
 			return val;
@@ -129,16 +274,98 @@ namespace Bits {
 			return *this;
 		}
 
-		void save() {EEPROM.put(memaddr, val);}
+		void save() {storage.store(val);}
 
 		inline operator T() const				{return get();		}
 		inline Record& operator=(T const& val)	{return set(val);	}
 
-		constexpr uint16 address() const {return memaddr;}
+		constexpr uint16 address() const {return storage.address();}
+
+		bool valid() const {return intact;}
+
+	private:
+		Storage storage;
+		T val;
+		bool intact = true;
+	};
+
+	/// @brief Write-back cached record.
+	/// @details Reads come from RAM. Changes are only committed to the EEPROM once the record has been left unchanged
+	/// for `COMMIT_DELAY` milliseconds (or when `save()` is called), so multiple changes coalesce into a single commit.
+	/// Only the bytes that differ from what is already in the EEPROM are written.
+	template <class T, bool AUTOINIT, uint8 VERSION>
+	struct Record<T, CacheType::BCT_CACHE_WRITE_BACK, AUTOINIT, VERSION> {
+		using Storage = RecordStorage<T, VERSION>;
+
+		constexpr static usize const SIZE = Storage::SIZE;
+
+		/// @brief Time, in milliseconds, a change must settle for before being committed.
+		constexpr static uint16 const COMMIT_DELAY = 1000;
+
+		Record(uint16 const address):
+			storage(address) {if (AUTOINIT) begin();}
+
+		void begin() {
+			if (!(intact = storage.load(val))) {
+				val = T{};
+				dirty = true;
+				save();
+			}
+		}
+
+		/// @brief Commits the cached value, if it has been left unchanged for long enough.
+		void update() {
+			if (dirty && millis() - changedAt >= COMMIT_DELAY)
+				save();
+		}
+
+		T get() const {
+			return val;
+		}
+
+		void fetch(T& out) const {
+			out = val;
+		}
+
+		Record& set(T const& v) {
+			if (memcmp(&val, &v, sizeof(T))) {
+				val			= v;
+				dirty		= true;
+				changedAt	= millis();
+			}
+			return *this;
+		}
+
+		void save() {
+			if (!dirty) return;
+			storage.store(val);
+			dirty = false;
+		}
+
+		/// @brief Discards any uncommitted changes, restoring the last committed value.
+		void revert() {
+			if (!dirty) return;
+			if (!storage.load(val))
+				val = T{};
+			dirty = false;
+		}
+
+		inline operator T() const				{return get();		}
+		inline Record& operator=(T const& val)	{return set(val);	}
+
+		constexpr uint16 address() const {return storage.address();}
+
+		bool valid() const {return intact;}
+
+		/// @brief Returns whether there are uncommitted changes.
+		bool pending() const {return dirty;}
 
 	private:
-		uint16 const memaddr;
+		Storage storage;
 		T val;
+		uint32 changedAt = 0;
+		bool intact	= true;
+		bool dirty	= false;
 	};
 }
 
@@ -0,0 +1,229 @@
+#ifndef BITS_RETENTION_H
+#define BITS_RETENTION_H
+
+#include "types.hpp"
+#include "units.hpp"
+#include "databank.hpp"
+
+/// @brief Helper classes & functions.
+namespace Bits {
+	/// @brief Statistic held by a summary entry.
+	enum class Statistic: uint8 {
+		BST_MIN,
+		BST_MAX,
+		BST_MEAN,
+	};
+
+	/// @brief Log entry tag. Tells samples apart from summaries.
+	struct PACKED LogTag {
+		/// @brief Summary tier. `0` for samples. A tier `n + 1` summary merges `RATIO` tier `n` items.
+		uint8 tier:	6;
+		/// @brief Statistic held by a summary entry, as a `Statistic`.
+		uint8 stat:	2;
+	};
+
+	/// @brief Log retention engine. Downsamples the oldest entries of a bank before it fills up.
+	/// @details The bank is seen as a sequence of items: samples (one entry) and summaries (three entries: min, max & mean).
+	/// Whenever the bank is about to fill up, the oldest run of `RATIO` items of the same tier is merged into a single summary
+	/// of the next tier, written in place over the end of the run. Older entries are then moved up, and the freed slots released.
+	/// Recent data stays at full resolution, while older data gets coarser and coarser. Once nothing can be merged anymore,
+	/// the oldest item is dropped as a whole.
+	///
+	/// Compaction runs incrementally, at most `BUDGET` entry writes per `update()`, so it never stalls the main loop.
+	/// New entries can be appended meanwhile. If existing entries are changed by anything else, compaction is abandoned and started over.
+	/// @note Entries must provide `uint32 timestamp`, a `value` made of `int16` fields, and `LogTag tag`.
+	/// @warning Like `DataBank::set()`, compaction rewrites entries in place. An interrupted compaction may leave duplicated entries
+	/// behind, but never a corrupted bank header.
+	/// @tparam Bank Data bank type.
+	/// @tparam RATIO Amount of items merged into a summary.
+	/// @tparam RESERVE Amount of free slots below which compaction starts.
+	/// @tparam BUDGET Maximum amount of entry writes per update.
+	template <class Bank, uint8 RATIO = 8, uint8 RESERVE = 2, uint8 BUDGET = 1>
+	struct Retention {
+		/// @brief Entry type.
+		using EntryType	= typename Bank::EntryType;
+		/// @brief Entry index type.
+		using IndexType	= typename Bank::IndexType;
+
+		/// @brief Amount of entries a summary takes up.
+		constexpr static uint8 const SUMMARY_SIZE	= 3;
+		/// @brief Highest summary tier.
+		constexpr static uint8 const MAX_TIER		= 63;
+
+		static_assert(RATIO > SUMMARY_SIZE, "Summaries must take up less room than what they merge!");
+		static_assert(BUDGET > 0);
+
+		/// @brief Compaction stage.
+		enum class Stage: uint8 {
+			BRS_IDLE,
+			BRS_WRITE,
+			BRS_MOVE,
+		};
+
+		/// @brief Constructs the retention engine.
+		/// @param bank Bank to manage.
+		Retention(Bank& bank): bank(bank) {}
+
+		/// @brief Advances compaction by one step, if the bank is under pressure.
+		void update() {
+			if (stage != Stage::BRS_IDLE && bank.revision() != revision)
+				stage = Stage::BRS_IDLE;
+			switch (stage) {
+				case Stage::BRS_IDLE:	start();	break;
+				case Stage::BRS_WRITE:	write();	break;
+				case Stage::BRS_MOVE:	move();		break;
+			}
+		}
+
+		/// @brief Returns whether a compaction is in progress.
+		bool busy() const {return stage != Stage::BRS_IDLE;}
+
+	private:
+		/// @brief Amount of `int16` fields in an entry's value.
+		constexpr static uint8 const FIELDS = sizeof(EntryType::value) / sizeof(int16);
+
+		static_assert(sizeof(EntryType::value) == FIELDS * sizeof(int16), "Log values must be made of int16 fields!");
+
+		/// @brief Returns the amount of entries an item of a given tier takes up.
+		constexpr static uint8 itemSize(uint8 const tier) {
+			return tier ? SUMMARY_SIZE : 1;
+		}
+
+		/// @brief Looks for a run to compact, and computes its summary.
+		void start() {
+			if (bank.capacity() - bank.size() > RESERVE) return;
+			if (searched && bank.revision() == revision && bank.size() == searchedSize) return;
+			revision		= bank.revision();
+			searched		= true;
+			searchedSize	= bank.size();
+			if (!find()) return expire();
+			summarize();
+			written	= 0;
+			stage	= Stage::BRS_WRITE;
+		}
+
+		/// @brief Finds the oldest run of `RATIO` items of the same tier.
+		/// @return Whether one was found.
+		bool find() {
+			typename Bank::Cursor cursor{bank};
+			uint8 items = 0;
+			while (cursor.valid()) {
+				IndexType const index	= cursor.index();
+				LogTag const tag		= (*cursor).tag;
+				uint8 const tier		= tag.tier;
+				if (!items || tier != runTier) {
+					runStart	= index;
+					runLength	= 0;
+					runTier		= tier;
+					items		= 0;
+				}
+				// Leftovers of an interrupted compaction are stepped over, one entry at a time.
+				bool const stray = tier && static_cast<Statistic>(tag.stat) != Statistic::BST_MIN;
+				cursor.seek(index + (stray ? 1 : itemSize(tier)));
+				if (stray || tier >= MAX_TIER) {
+					items = 0;
+					continue;
+				}
+				runLength += itemSize(tier);
+				if (++items == RATIO)
+					return runStart + runLength <= bank.size();
+			}
+			return false;
+		}
+
+		/// @brief Drops the oldest item as a whole, when nothing can be merged anymore.
+		void expire() {
+			LogTag const tag = bank.get(0).tag;
+			bool const stray = tag.tier && static_cast<Statistic>(tag.stat) != Statistic::BST_MIN;
+			bank.fastShiftDown(stray ? 1 : itemSize(tag.tier));
+			searched = false;
+		}
+
+		/// @brief Merges the run into a summary.
+		void summarize() {
+			int16	low[FIELDS], high[FIELDS];
+			int32	sum[FIELDS] = {};
+			for (uint8 f = 0; f < FIELDS; ++f) {
+				low[f]	= 0x7FFF;
+				high[f]	= -0x7FFF - 1;
+			}
+			typename Bank::Cursor cursor{bank, runStart};
+			summary[0] = *cursor;
+			for (IndexType i = 0; i < runLength; ++i, ++cursor) {
+				EntryType const& e = *cursor;
+				int16 fields[FIELDS];
+				memcpy(fields, &e.value, sizeof(fields));
+				bool const samples = !runTier;
+				Statistic const stat = static_cast<Statistic>(e.tag.stat);
+				for (uint8 f = 0; f < FIELDS; ++f) {
+					if ((samples || stat == Statistic::BST_MIN) && fields[f] < low[f])
+						low[f] = fields[f];
+					if ((samples || stat == Statistic::BST_MAX) && fields[f] > high[f])
+						high[f] = fields[f];
+					if (samples || stat == Statistic::BST_MEAN)
+						sum[f] += fields[f];
+				}
+			}
+			for (uint8 f = 0; f < FIELDS; ++f)
+				sum[f] = Units::divRound(sum[f], RATIO);
+			summary[1] = summary[2] = summary[0];
+			memcpy(&summary[0].value, low, sizeof(low));
+			memcpy(&summary[1].value, high, sizeof(high));
+			int16 mean[FIELDS];
+			for (uint8 f = 0; f < FIELDS; ++f)
+				mean[f] = Units::saturate(sum[f]);
+			memcpy(&summary[2].value, mean, sizeof(mean));
+			for (uint8 s = 0; s < SUMMARY_SIZE; ++s)
+				summary[s].tag = {static_cast<uint8>(runTier + 1), s};
+		}
+
+		/// @brief Writes the summary over the end of the run.
+		void write() {
+			for (uint8 n = 0; n < BUDGET && written < SUMMARY_SIZE; ++n, ++written)
+				bank.set(runStart + runLength - SUMMARY_SIZE + written, summary[written]);
+			revision = bank.revision();
+			if (written < SUMMARY_SIZE) return;
+			moved = 0;
+			stage = Stage::BRS_MOVE;
+		}
+
+		/// @brief Moves the entries older than the run up against the summary, then releases the freed slots.
+		void move() {
+			IndexType const shift = runLength - SUMMARY_SIZE;
+			for (uint8 n = 0; n < BUDGET && moved < runStart; ++n, ++moved) {
+				IndexType const from = runStart - 1 - moved;
+				bank.set(from + shift, bank.get(from));
+			}
+			revision = bank.revision();
+			if (moved < runStart) return;
+			bank.fastShiftDown(shift);
+			searched	= false;
+			stage		= Stage::BRS_IDLE;
+		}
+
+		/// @brief Bank to manage.
+		Bank&		bank;
+		/// @brief Current stage.
+		Stage		stage		= Stage::BRS_IDLE;
+		/// @brief Bank revision, as last seen (or changed) by the engine.
+		uint8		revision	= 0;
+		/// @brief Whether the bank was already searched for a run, as it was last seen.
+		bool		searched	= false;
+		/// @brief Bank size at the last search.
+		IndexType	searchedSize	= 0;
+		/// @brief First entry of the run being compacted.
+		IndexType	runStart	= 0;
+		/// @brief Amount of entries in the run being compacted.
+		IndexType	runLength	= 0;
+		/// @brief Tier of the run being compacted.
+		uint8		runTier		= 0;
+		/// @brief Summary entries written so far.
+		uint8		written		= 0;
+		/// @brief Older entries moved so far.
+		IndexType	moved		= 0;
+		/// @brief Summary of the run being compacted.
+		EntryType	summary[SUMMARY_SIZE];
+	};
+}
+
+#endif
@@ -3,8 +3,13 @@
 
 #include "types.hpp"
 #include "record.hpp"
+#include "units.hpp"
+#include "crc.hpp"
+#include "alarm.hpp"
+#include "display.hpp"
 
 #include <DHT.h>
+#include <Wire.h>
 
 namespace Bits {
 	struct Sensor {
@@ -28,42 +33,44 @@ namespace Bits {
 			Threshold	threshold;
 		};
 
-		Sensor(avr_pin const pin, eeprom_address const info):
-			pin(pin), info(info), dht(pin, DHT11) {
+		using InfoRecord = Record<Info, CacheType::BCT_CACHE_WRITE_BACK>;
+
+		using Reading = Value;
+
+		constexpr static uint8 const PAGES = 1;
+
+		Sensor(eeprom_address const info):
+			info(info) {
 		}
 
 		void begin() {
-			dht.begin();
 			info.begin();
+			apply();
 		}
 
-		Value read() const {
-			return toCurrentUnit(readRaw());
-		}
+		void update()	{info.update();	}
+		void save()		{info.save();	}
+		void revert()	{info.revert();	}
 
-		Value readRaw() const {
-			return Value{
-				dht.readTemperature()	* 100,
-				dht.readHumidity()		* 100
-			};
-		}
+		/// @brief Makes the configured thresholds the ones `check()` uses.
+		void apply()	{armed = info.get().threshold;	}
 
 		Value toCurrentUnit(Value v) const {
 			switch (info.get().unit) {
 				default:
 				case Unit::BSU_CELSIUS: break;
-				case Unit::BSU_FARENHEIT:	v.temperature = (v.temperature * 1.8 + 3200);	break;
-				case Unit::BSU_KELVIN:		v.temperature += 27315;							break;
+				case Unit::BSU_FARENHEIT:	v.temperature = Units::saturate(Units::celsiusToFarenheit(v.temperature));	break;
+				case Unit::BSU_KELVIN:		v.temperature = Units::saturate(Units::celsiusToKelvin(v.temperature));		break;
 			}
 			return v;
 		}
 		
-		constexpr int16 toCelcius(int16 const value, Unit const unit) {
+		constexpr static int16 toCelcius(int32 const value, Unit const unit) {
 			switch (unit) {
 				default:
-				case Unit::BSU_CELSIUS:		return value;
-				case Unit::BSU_FARENHEIT:	return (value - 3200) * (5.0/9.0);
-				case Unit::BSU_KELVIN:		return value - 27315;
+				case Unit::BSU_CELSIUS:		return Units::saturate(value);
+				case Unit::BSU_FARENHEIT:	return Units::saturate(Units::farenheitToCelsius(value));
+				case Unit::BSU_KELVIN:		return Units::saturate(Units::kelvinToCelsius(value));
 			}
 		}
 
@@ -87,21 +94,58 @@ namespace Bits {
 			return info.get().threshold;
 		}
 
-		bool inTheDangerZone() const {
-			return !inTheSafeZone();
+		bool inTheSafeZone(Value const& v) const {
+			return temperatureOK(v) && humidityOK(v);
+		}
+
+		bool temperatureOK(Value const& v) const {
+			return isTemperatureOK(v.temperature, info.get().threshold);
+		}
+
+		bool humidityOK(Value const& v) const {
+			return isHumidityOK(v.humidity, info.get().threshold);
+		}
+
+		/// @brief Returns whether a reading holds actual measurements.
+		constexpr static bool measured(Reading const& v) {
+			return v.temperature != Units::MISSING && v.humidity != Units::MISSING;
+		}
+
+		Alarm::Pattern check(Reading const& v) const {
+			if (!isTemperatureOK(v.temperature, armed))	return Alarm::Pattern::BAP_TEMPERATURE;
+			if (!isHumidityOK(v.humidity, armed))		return Alarm::Pattern::BAP_HUMIDITY;
+			return Alarm::Pattern::BAP_OK;
+		}
+
+		String toString(Reading const& r) const {
+			auto const v = toCurrentUnit(r);
+			return (
+				"Temperature: [" + Units::toString(v.temperature) + static_cast<char>(getUnit()) + "], "
+				"Humidity: [" + Units::toString(v.humidity) + "%]"
+			);
+		}
+
+		String toValues(Reading const& r) const {
+			return String(r.temperature) + "," + String(r.humidity);
+		}
+
+		void show(Display& display, Reading const& r, uint8 const) const {
+			auto const v = toCurrentUnit(r);
+			display.writeDecimal(v.temperature, static_cast<char>(getUnit()), 1, 1);
+			display.writeDecimal(v.humidity, '%', 8, 1);
 		}
 
-		bool inTheSafeZone() const {
-			auto const v			= readRaw();
-			auto const threshold	= info.get().threshold;
+		bool consistent() const {
+			auto const t = info.get().threshold;
 			return (
-				isTemperatureOK(v.temperature, threshold)
-			&&	isHumidityOK(v.humidity, threshold)
+				t.min.temperature <= t.max.temperature
+			&&	t.min.humidity <= t.max.humidity
 			);
 		}
 
+		bool valid() const		{return info.valid();				}
 		uint16 address() const	{return info.address();				}
-		uint16 end() const		{return address()	+ sizeof(Info);	}
+		uint16 end() const		{return address()	+ InfoRecord::SIZE;		}
 
 	private:
 		constexpr static bool isTemperatureOK(int16 const t, Threshold const& threshold) {
@@ -118,9 +162,171 @@ namespace Bits {
 			);
 		}
 
-		uint8 const		pin;
-		Record<Info>	info;
-		DHT				dht;
+		InfoRecord		info;
+		/// @brief Thresholds readings are checked against, as of the last `apply()`.
+		Threshold		armed;
+	};
+
+	/// @brief DHT-family sensor backend.
+	/// @tparam TYPE DHT sensor type (`DHT11`, `DHT22`...).
+	/// @tparam RES Resolution, in cents.
+	/// @tparam INT Minimum time between readings, in milliseconds.
+	template <uint8 TYPE, uint16 RES, uint16 INT>
+	struct DHTBackend {
+		/// @brief Resolution, in cents.
+		constexpr static uint16 const RESOLUTION	= RES;
+		/// @brief Minimum time between readings, in milliseconds.
+		constexpr static uint16 const INTERVAL		= INT;
+
+		DHTBackend(avr_pin const pin): dht(pin, TYPE) {}
+
+		void begin() {dht.begin();}
+
+		/// @brief Reads the sensor.
+		/// @param out Where to store the reading, in celsius cents & humidity cents.
+		/// @return Whether the reading succeeded.
+		bool read(Sensor::Value& out) {
+			float const t = dht.readTemperature(), h = dht.readHumidity();
+			if (isnan(t) || isnan(h)) return false;
+			out = {
+				Units::saturate(Units::fromFloat(t)),
+				Units::saturate(Units::fromFloat(h))
+			};
+			return true;
+		}
+
+	private:
+		DHT dht;
+	};
+
+	/// @brief DHT11 backend. 1 °C / 1 % resolution, at most one reading per second.
+	using DHT11Backend = DHTBackend<DHT11, 100, 1000>;
+	/// @brief DHT22/AM2302 backend. 0.1 °C / 0.1 % resolution, at most one reading every two seconds.
+	using DHT22Backend = DHTBackend<DHT22, 10, 2000>;
+
+	/// @brief SHT3x measurement mode.
+	enum class SHT3xMode: uint8 {
+		/// @brief A measurement is triggered after every reading, and fetched on the next one.
+		BSM_SINGLE_SHOT,
+		/// @brief The sensor measures on its own, 10 times per second.
+		BSM_PERIODIC,
+	};
+
+	/// @brief Sensirion SHT3x (I2C) sensor backend. 0.01 °C / 0.01 % resolution.
+	/// @note Readings are never waited for. Each reading returns the latest measurement, triggered (or made) beforehand.
+	/// @tparam MODE Measurement mode.
+	/// @tparam ADDRESS I2C address (`0x44`, or `0x45` with ADDR pulled high).
+	template <SHT3xMode MODE = SHT3xMode::BSM_SINGLE_SHOT, uint8 ADDRESS = 0x44>
+	struct SHT3xBackend {
+		/// @brief Resolution, in cents.
+		constexpr static uint16 const RESOLUTION	= 1;
+		/// @brief Minimum time between readings, in milliseconds. Covers the high repeatability measurement duration.
+		constexpr static uint16 const INTERVAL		= (MODE == SHT3xMode::BSM_PERIODIC) ? 100 : 20;
+
+		/// @brief Constructs the backend.
+		/// @note The pin is unused. The sensor sits on the I2C bus.
+		SHT3xBackend(avr_pin const) {}
+
+		void begin() {
+			Wire.begin();
+			if (MODE == SHT3xMode::BSM_PERIODIC)
+				command(CMD_PERIODIC_10MPS_HIGH);
+			else command(CMD_SINGLE_SHOT_HIGH);
+		}
+
+		/// @brief Reads the sensor.
+		/// @param out Where to store the reading, in celsius cents & humidity cents.
+		/// @return Whether the reading succeeded.
+		bool read(Sensor::Value& out) {
+			if (MODE == SHT3xMode::BSM_PERIODIC && !command(CMD_FETCH))
+				return false;
+			uint8 data[6];
+			bool const ok = fetch(data);
+			if (MODE == SHT3xMode::BSM_SINGLE_SHOT)
+				command(CMD_SINGLE_SHOT_HIGH);
+			if (!ok) return false;
+			uint16 const
+				t = (static_cast<uint16>(data[0]) << 8) | data[1],
+				h = (static_cast<uint16>(data[3]) << 8) | data[4]
+			;
+			out = {
+				Units::saturate(Units::divRound(17500l * t, 65535) - 4500),
+				Units::saturate(Units::divRound(10000l * h, 65535))
+			};
+			return true;
+		}
+
+	private:
+		/// @brief Single-shot, high repeatability, no clock stretching.
+		constexpr static uint16 const CMD_SINGLE_SHOT_HIGH		= 0x2400;
+		/// @brief Periodic, 10 measurements per second, high repeatability.
+		constexpr static uint16 const CMD_PERIODIC_10MPS_HIGH	= 0x2737;
+		/// @brief Fetch periodic measurement data.
+		constexpr static uint16 const CMD_FETCH					= 0xE000;
+
+		static bool command(uint16 const cmd) {
+			Wire.beginTransmission(ADDRESS);
+			Wire.write(cmd >> 8);
+			Wire.write(cmd & 0xFF);
+			return Wire.endTransmission() == 0;
+		}
+
+		static bool fetch(uint8 (&data)[6]) {
+			if (Wire.requestFrom(ADDRESS, static_cast<uint8>(6)) != 6) return false;
+			for (uint8& b: data)
+				b = Wire.read();
+			return (
+				CRC::sensirion(data, 2)		== data[2]
+			&&	CRC::sensirion(data + 3, 2)	== data[5]
+			);
+		}
+	};
+
+	/// @brief Temperature & humidity sensor channel.
+	/// @tparam Backend Sensor backend (`DHT11Backend`, `DHT22Backend`, `SHT3xBackend<...>`).
+	template <class Backend = DHT11Backend>
+	struct BasicSensor: Sensor {
+		/// @brief Resolution, in cents.
+		constexpr static uint16 const RESOLUTION	= Backend::RESOLUTION;
+		/// @brief Minimum time between samples, in milliseconds.
+		constexpr static uint16 const INTERVAL		= Backend::INTERVAL;
+
+		BasicSensor(avr_pin const pin, eeprom_address const info):
+			Sensor(info), backend(pin) {
+		}
+
+		void begin() {
+			backend.begin();
+			Sensor::begin();
+		}
+
+		Value read() {
+			return toCurrentUnit(readRaw());
+		}
+
+		/// @brief Reads the sensor. If the reading fails, returns the last successful one, or a `MISSING` one if none ever succeeded.
+		Value readRaw() {
+			backend.read(last);
+			return last;
+		}
+
+		Reading sample() {
+			return readRaw();
+		}
+
+		using Sensor::inTheSafeZone;
+
+		bool inTheSafeZone() {
+			return inTheSafeZone(readRaw());
+		}
+
+		bool inTheDangerZone() {
+			return !inTheSafeZone();
+		}
+
+	private:
+		Backend	backend;
+		Value	last	= {Units::MISSING, Units::MISSING};
 	};
 }
 
@@ -0,0 +1,152 @@
+#ifndef BITS_STAGING_H
+#define BITS_STAGING_H
+
+#include "types.hpp"
+#include "interrupts.hpp"
+
+/// @brief Helper classes & functions.
+namespace Bits {
+	/// @brief RAM staging queue for new bank entries, written to the EEPROM in the background.
+	/// @details Each entry is written one byte per EEPROM-ready interrupt, then committed by writing the bank's header the same way.
+	/// Bytes that already hold the right value are skipped.
+	///
+	/// The interrupt is only enabled between `resume()` and `pause()`, i.e. while the loop sleeps, so it never races the loop's own
+	/// EEPROM accesses. While anything is staged, the queue owns the bank's header: nothing else may commit it until the queue
+	/// is empty, or it would interleave with the header slot being written. Until an entry is committed, it only exists in RAM,
+	/// and is lost on a power cut: `flush()` writes everything out synchronously, and should be called before resetting.
+	/// @tparam Bank Data bank type.
+	/// @tparam N Amount of entries that can be staged.
+	template <class Bank, uint8 N = 4>
+	struct Staging {
+		/// @brief Entry type.
+		using EntryType = typename Bank::EntryType;
+
+		static_assert(N > 0);
+
+		/// @brief Constructs the staging queue.
+		/// @param bank Bank to record entries into.
+		Staging(Bank& bank): bank(bank) {}
+
+		/// @brief Initializes the staging queue.
+		void begin() {
+			Interrupts<Vector::BV_EE_READY>::bind<&Staging::onReady>(*this);
+		}
+
+		/// @brief Stages an entry. If the queue is full, it is flushed first.
+		/// @param entry Entry to record.
+		void record(EntryType const& entry) {
+			if (full()) flush();
+			entries[(head + count) % N] = entry;
+			++count;
+		}
+
+		/// @brief Lets the background writer run.
+		void resume() {
+			if (!empty())
+				EECR |= _BV(EERIE);
+		}
+
+		/// @brief Stops the background writer. A byte write already started still completes.
+		void pause() {
+			EECR &= ~_BV(EERIE);
+		}
+
+		/// @brief Writes every staged entry out, waiting on each byte.
+		void flush() {
+			pause();
+			while (!empty())
+				step();
+		}
+
+		/// @brief Drops every staged entry. The one being written, if any, is finished first, so the header is left intact.
+		void clear() {
+			pause();
+			count = (offset || header) ? 1 : 0;
+			flush();
+		}
+
+		/// @brief Returns the amount of staged entries.
+		uint8 size() const	{return count;		}
+		/// @brief Returns whether nothing is staged.
+		bool empty() const	{return !count;		}
+		/// @brief Returns whether the queue is full.
+		bool full() const	{return count == N;	}
+
+	private:
+		/// @brief Header slot type.
+		using HeaderSlot = typename Bank::HeaderStorage::Slot;
+
+		/// @brief Called once the EEPROM is ready for the next byte.
+		void onReady() {
+			step();
+			if (empty()) pause();
+		}
+
+		/// @brief Writes the next byte that differs from what is stored, and advances through the entry, then the header.
+		void step() {
+			while (!empty()) {
+				if (!offset && !header)
+					address = bank.recordAddress();
+				uint8 const size	= header ? sizeof(HeaderSlot) : sizeof(EntryType);
+				if (offset < size) {
+					uint8 const* const data = header
+					?	reinterpret_cast<uint8 const*>(&slot)
+					:	reinterpret_cast<uint8 const*>(&entries[head])
+					;
+					uint8 const at = offset++;
+					if (write(address + at, data[at])) return;
+					continue;
+				}
+				offset = 0;
+				if (header) {
+					header	= false;
+					head	= (head + 1) % N;
+					--count;
+				} else if (bank.recordAddress() == address) {
+					slot	= bank.recordWritten();
+					address	= bank.headerAddress();
+					header	= true;
+				}
+			}
+		}
+
+		/// @brief Starts writing a byte, unless it already holds the value.
+		/// @param at EEPROM address.
+		/// @param value Value to write.
+		/// @return Whether a write was started.
+		static bool write(eeprom_address const at, uint8 const value) {
+			while (EECR & _BV(EEPE));
+			uint8 const sreg = SREG;
+			cli();
+			EEAR = at;
+			EECR |= _BV(EERE);
+			bool const differs = EEDR != value;
+			if (differs) {
+				EEDR = value;
+				EECR |= _BV(EEMPE);
+				EECR |= _BV(EEPE);
+			}
+			SREG = sreg;
+			return differs;
+		}
+
+		/// @brief Bank to record entries into.
+		Bank&				bank;
+		/// @brief Staged entries.
+		EntryType			entries[N];
+		/// @brief Header slot being written.
+		HeaderSlot			slot;
+		/// @brief Oldest staged entry.
+		volatile uint8		head		= 0;
+		/// @brief Amount of staged entries.
+		volatile uint8		count		= 0;
+		/// @brief Next byte to write, in the entry or header slot.
+		uint8				offset		= 0;
+		/// @brief Whether the header slot is being written.
+		bool				header		= false;
+		/// @brief EEPROM address of the entry or header slot being written.
+		eeprom_address		address		= 0;
+	};
+}
+
+#endif
@@ -44,6 +44,11 @@ using address = void const*;
 template <class T>
 using As = T;
 
+template <class A, class B>	constexpr bool IsSame		= false;
+template <class A>			constexpr bool IsSame<A, A>	= true;
+
+template <class B, class D>	constexpr bool IsBaseOf		= __is_base_of(B, D);
+
 #define PACKED [[gnu::aligned(1)]]
 
 #endif
\ No newline at end of file
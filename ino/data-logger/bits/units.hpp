@@ -0,0 +1,133 @@
+#ifndef BITS_UNITS_H
+#define BITS_UNITS_H
+
+#include "types.hpp"
+
+/// @brief Helper classes & functions.
+namespace Bits {
+	/// @brief Fixed-point unit conversion functions.
+	/// @note All values are in hundredths (cents) of their unit. Rounding is always half away from zero.
+	namespace Units {
+		/// @brief Fixed-point scale.
+		constexpr int32 const SCALE = 100;
+
+		/// @brief Largest whole part `parse` accepts. Keeps parsed values, and their conversions, well inside `int32`.
+		constexpr int32 const MAX_WHOLE = 999999;
+
+		/// @brief Value `parse` returns for out-of-range input.
+		constexpr int32 const INVALID = INT32_MIN;
+
+		/// @brief Reading field value standing in for a reading that never succeeded.
+		constexpr int16 const MISSING = INT16_MIN;
+
+		/// @brief Divides two integers, rounding half away from zero.
+		/// @param num Dividend.
+		/// @param den Divisor. Must be positive.
+		/// @return Rounded quotient.
+		constexpr int32 divRound(int32 const num, int32 const den) {
+			return (num < 0) ? -((-num + den / 2) / den) : ((num + den / 2) / den);
+		}
+
+		/// @brief Saturates a value to the `int16` range.
+		/// @param value Value to saturate.
+		/// @return Saturated value.
+		constexpr int16 saturate(int32 const value) {
+			return (value < INT16_MIN) ? INT16_MIN : ((value > INT16_MAX) ? INT16_MAX : value);
+		}
+
+		/// @brief Converts a floating-point value into cents.
+		/// @param value Value to convert.
+		/// @return Value in cents.
+		/// @note Only meant for converting values coming from libraries with floating-point APIs.
+		constexpr int32 fromFloat(float const value) {
+			return static_cast<int32>(value * SCALE + ((value < 0) ? -0.5f : 0.5f));
+		}
+
+		/// @brief Converts from celsius to farenheit.
+		constexpr int32 celsiusToFarenheit(int32 const cents)	{return divRound(cents * 9, 5) + 3200;	}
+		/// @brief Converts from farenheit to celsius.
+		constexpr int32 farenheitToCelsius(int32 const cents)	{return divRound((cents - 3200) * 5, 9);	}
+		/// @brief Converts from celsius to kelvin.
+		constexpr int32 celsiusToKelvin(int32 const cents)		{return cents + 27315;					}
+		/// @brief Converts from kelvin to celsius.
+		constexpr int32 kelvinToCelsius(int32 const cents)		{return cents - 27315;					}
+
+		/// @brief Rounds a value (in cents) to a given amount of decimal places.
+		/// @param cents Value to round.
+		/// @param decimals Decimal places to keep (`0`, `1` or `2`).
+		/// @return Rounded value, in `10^-decimals` units.
+		constexpr int32 round(int32 const cents, uint8 const decimals) {
+			return (decimals >= 2) ? cents : divRound(cents, (decimals == 1) ? 10 : 100);
+		}
+
+		/// @brief Parses a decimal number string into cents, without floating-point math.
+		/// @param str String to parse (e.g. `"-12.345"`). Parsing stops at the first invalid character.
+		/// @return Parsed value, in cents, or `INVALID` if the whole part exceeds `MAX_WHOLE`.
+		constexpr int32 parse(char const* str) {
+			bool negative = false;
+			if (*str == '-' || *str == '+')
+				negative = (*str++ == '-');
+			int32 whole = 0, frac = 0;
+			while ('0' <= *str && *str <= '9') {
+				whole = whole * 10 + (*str++ - '0');
+				if (whole > MAX_WHOLE) return INVALID;
+			}
+			if (*str == '.') {
+				++str;
+				for (uint8 i = 0; i < 3; ++i) {
+					frac *= 10;
+					if ('0' <= *str && *str <= '9')
+						frac += *str++ - '0';
+				}
+			}
+			int32 const value = whole * SCALE + divRound(frac, 10);
+			return negative ? -value : value;
+		}
+
+		/// @brief Returns a value (in cents) as a decimal string, without floating-point math.
+		/// @param cents Value to convert.
+		/// @param decimals Decimal places to show (`0`, `1` or `2`).
+		/// @return Value as string.
+		inline String toString(int32 const cents, uint8 const decimals = 2) {
+			int32 const value = round(cents, decimals);
+			uint32 const abs = (value < 0) ? -value : value;
+			String str = (value < 0) ? "-" : "";
+			switch (decimals) {
+				case 0:		str += String(abs);															break;
+				case 1:		str += String(abs / 10) + "." + String(abs % 10);							break;
+				default:	str += String(abs / 100) + "." + String((abs / 10) % 10) + String(abs % 10);	break;
+			}
+			return str;
+		}
+
+		static_assert(divRound(5, 10) == 1);
+		static_assert(divRound(-5, 10) == -1);
+		static_assert(divRound(4, 10) == 0);
+		static_assert(saturate(40000) == INT16_MAX);
+		static_assert(celsiusToFarenheit(0) == 3200);
+		static_assert(celsiusToFarenheit(2500) == 7700);
+		static_assert(celsiusToFarenheit(-4000) == -4000);
+		static_assert(celsiusToFarenheit(1) == 3202);
+		static_assert(farenheitToCelsius(7700) == 2500);
+		static_assert(farenheitToCelsius(3201) == 1);
+		static_assert(farenheitToCelsius(-4000) == -4000);
+		static_assert(celsiusToKelvin(kelvinToCelsius(30000)) == 30000);
+		static_assert(round(1255, 1) == 126);
+		static_assert(round(-1255, 0) == -13);
+		static_assert(parse("12") == 1200);
+		static_assert(parse("-12.5") == -1250);
+		static_assert(parse("0.125") == 13);
+		static_assert(parse("+3.14159") == 314);
+		static_assert(parse(".5") == 50);
+		static_assert(parse("abc") == 0);
+		static_assert(parse("-999999.99") == -99999999);
+		static_assert(parse("1000000") == INVALID);
+		static_assert(parse("99999999999") == INVALID);
+		static_assert(farenheitToCelsius(parse("999999.99")) > 0);
+		static_assert(celsiusToFarenheit(parse("-999999.99")) < 0);
+		static_assert(fromFloat(24.9f) == 2490);
+		static_assert(fromFloat(-0.015f) == -2);
+	}
+}
+
+#endif
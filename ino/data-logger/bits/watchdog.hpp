@@ -0,0 +1,197 @@
+#ifndef BITS_WATCHDOG_H
+#define BITS_WATCHDOG_H
+
+#include <avr/wdt.h>
+
+#include "types.hpp"
+#include "core.hpp"
+#include "record.hpp"
+#include "interrupts.hpp"
+
+/// @brief Helper classes & functions.
+namespace Bits {
+	namespace {
+		/// @brief Stall breadcrumb, as left in RAM by the watchdog interrupt.
+		struct PACKED WatchdogStall {
+			/// @brief Value `mark` holds while the breadcrumb awaits the following boot.
+			constexpr static uint16 const MARK = 0x5CA1;
+
+			/// @brief Stage the main loop stalled in, as a `Watchdog::Stage`.
+			uint8	stage;
+			/// @brief Duration of the last complete loop before the stall, in milliseconds.
+			uint16	loopTime;
+			/// @brief Uptime when the stall was caught, in milliseconds.
+			uint32	uptime;
+			/// @brief `MARK` if the breadcrumb is valid. RAM holds garbage after a power-on.
+			uint16	mark;
+		};
+
+		/// @brief Stall breadcrumb. Survives the watchdog reset, since `.noinit` RAM is not cleared at boot.
+		[[gnu::section(".noinit")]]
+		static WatchdogStall stall;
+	}
+
+	/// @brief Watchdog service.
+	/// @details The watchdog runs in interrupt-and-reset mode: if the main loop stalls for `TIMEOUT`, the watchdog interrupt
+	/// first leaves a breadcrumb in `.noinit` RAM, and the following timeout resets the MCU. The next boot then saves it into the EEPROM.
+	/// If the loop recovers before the reset, the breadcrumb is dropped, and the interrupt re-armed.
+	struct Watchdog {
+		/// @brief Main loop stage.
+		enum class Stage: uint8 {
+			BWS_UNKNOWN,
+			BWS_BOOT,
+			BWS_COMMAND,
+			BWS_RECORDS,
+			BWS_ANIMATION,
+			BWS_SENSING,
+			BWS_DISPLAY,
+			BWS_SLEEP,
+		};
+
+		/// @brief Crash breadcrumb, to be stored in the EEPROM.
+		struct PACKED Breadcrumb {
+			/// @brief Stage the main loop stalled in, if it was caught by the watchdog.
+			Stage	stage;
+			/// @brief Reset cause flags (`MCUSR`) of the following boot.
+			uint8	resetCause;
+			/// @brief Duration of the last complete loop before the stall, in milliseconds.
+			uint16	loopTime;
+			/// @brief Uptime when the stall was caught, in milliseconds.
+			uint32	uptime;
+			/// @brief Amount of abnormal (watchdog or brown-out) resets so far.
+			uint8	resets;
+		};
+
+		/// @brief Breadcrumb record type.
+		using BreadcrumbRecord = Record<Breadcrumb, CacheType::BCT_CACHE_MANUAL_SAVE>;
+
+		/// @brief Watchdog timeout.
+		constexpr static uint8 const TIMEOUT = WDTO_8S;
+
+		/// @brief Constructs the watchdog service.
+		/// @param crumb EEPROM address of the crash breadcrumb.
+		Watchdog(eeprom_address const crumb):
+			crumb(crumb) {}
+
+		/// @brief Completes the breadcrumb after an abnormal reset, and starts the watchdog.
+		void begin() {
+			crumb.begin();
+			uint8 const cause = resetCause();
+			bool const requested = resetRequested();
+			resetRequest = 0;
+			if (!requested && (cause & (_BV(WDRF) | _BV(BORF)))) {
+				auto c = crumb.get();
+				if ((cause & _BV(WDRF)) && stall.mark == WatchdogStall::MARK) {
+					c.stage		= static_cast<Stage>(stall.stage);
+					c.loopTime	= stall.loopTime;
+					c.uptime	= stall.uptime;
+				} else {
+					c.stage		= Stage::BWS_UNKNOWN;
+					c.loopTime	= 0;
+					c.uptime	= 0;
+				}
+				c.resetCause	= cause;
+				if (c.resets < 0xFF) ++c.resets;
+				crumb = c;
+				crumb.save();
+			}
+			stall.mark = 0;
+			Interrupts<Vector::BV_WDT>::bind<&Watchdog::onTimeout>(*this);
+			arm();
+		}
+
+		/// @brief Kicks the watchdog. Must be called once per main loop cycle.
+		/// @details If the watchdog interrupt fired (which disables it) and the loop still made it here, the loop recovered:
+		/// the breadcrumb is dropped, and the interrupt re-armed for the next stall.
+		void kick() {
+			wdt_reset();
+			if (!(WDTCSR & _BV(WDIE))) {
+				stall.mark = 0;
+				arm();
+			}
+			uint32 const now = millis();
+			loopTime	= now - loopStart;
+			loopStart	= now;
+		}
+
+		/// @brief Kicks the watchdog during long operations, without counting it as a new loop cycle.
+		static void keepAlive() {wdt_reset();}
+
+		/// @brief Marks the main loop as entering a given stage.
+		/// @param next Stage entered.
+		void enter(Stage const next) {stage = next;}
+
+		/// @brief Turns the watchdog into a wake-up timer, for deep sleep.
+		/// @param wdto Wake-up period, as a `WDTO_*` value.
+		void beginSleep(uint8 const wdto) {
+			woken		= false;
+			sleeping	= true;
+			configure(_BV(WDIE) | prescaler(wdto));
+		}
+
+		/// @brief Turns the watchdog back into a stall detector, after deep sleep.
+		/// @return Whether the sleep ended because of the watchdog.
+		bool endSleep() {
+			arm();
+			sleeping = false;
+			return woken;
+		}
+
+		/// @brief Returns the stored crash breadcrumb.
+		Breadcrumb breadcrumb() const {return crumb.get();}
+
+		/// @brief Returns the duration of the last complete loop, in milliseconds.
+		uint16 lastLoopTime() const {return loopTime;}
+
+	private:
+		/// @brief Returns the `WDTCSR` prescaler bits for a given `WDTO_*` value.
+		constexpr static uint8 prescaler(uint8 const wdto) {
+			return (wdto & 7) | ((wdto & 8) ? _BV(WDP3) : 0);
+		}
+
+		/// @brief Configures the watchdog.
+		/// @param wdtcsr Value to set `WDTCSR` to.
+		static void configure(uint8 const wdtcsr) {
+			uint8 const sreg = SREG;
+			cli();
+			wdt_reset();
+			MCUSR &= ~_BV(WDRF);
+			WDTCSR = _BV(WDCE) | _BV(WDE);
+			WDTCSR = wdtcsr;
+			SREG = sreg;
+		}
+
+		/// @brief Arms the watchdog in interrupt-and-reset mode.
+		void arm() {
+			configure(_BV(WDIE) | _BV(WDE) | prescaler(TIMEOUT));
+		}
+
+		/// @brief Watchdog interrupt handler. Leaves the breadcrumb in RAM, then lets the next timeout reset the MCU.
+		/// @note The EEPROM is not touched here: the main loop may be in the middle of an EEPROM write.
+		void onTimeout() {
+			if (sleeping) {
+				woken = true;
+				return;
+			}
+			stall.stage		= static_cast<uint8>(stage);
+			stall.loopTime	= loopTime;
+			stall.uptime	= millis();
+			stall.mark		= WatchdogStall::MARK;
+		}
+
+		/// @brief Crash breadcrumb.
+		BreadcrumbRecord	crumb;
+		/// @brief Current main loop stage.
+		volatile Stage		stage		= Stage::BWS_BOOT;
+		/// @brief Start of the current loop cycle.
+		uint32				loopStart	= 0;
+		/// @brief Duration of the last complete loop cycle.
+		uint16				loopTime	= 0;
+		/// @brief Whether the watchdog is being used as a wake-up timer.
+		volatile bool		sleeping	= false;
+		/// @brief Whether the last deep sleep ended because of the watchdog.
+		volatile bool		woken		= false;
+	};
+}
+
+#endif
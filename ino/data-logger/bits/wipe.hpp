@@ -0,0 +1,74 @@
+#ifndef BITS_WIPE_H
+#define BITS_WIPE_H
+
+#include <EEPROM.h>
+#include <avr/eeprom.h>
+
+#include "types.hpp"
+
+/// @brief Helper classes & functions.
+namespace Bits {
+	/// @brief Background EEPROM wipe.
+	/// @details Clears the EEPROM a little at a time, and never waits on a write: a cell is only written once the previous write is done.
+	/// Cells that are already clear are skipped. Once everything is clear, the whole EEPROM is read back to verify it,
+	/// and any cell that is not clear is wiped again.
+	/// @tparam READS Maximum amount of cells checked per update.
+	template <uint8 READS = 32>
+	struct Wipe {
+		/// @brief Wipe stage.
+		enum class Stage: uint8 {
+			BEW_IDLE,
+			BEW_CLEAR,
+			BEW_VERIFY,
+			BEW_DONE,
+		};
+
+		static_assert(READS > 0);
+
+		/// @brief Starts wiping.
+		void start() {
+			cell	= 0;
+			stage	= Stage::BEW_CLEAR;
+		}
+
+		/// @brief Advances the wipe. Writes at most one cell, and only if the EEPROM is ready for it.
+		void update() {
+			for (uint8 n = 0; n < READS; ++n) {
+				if (stage != Stage::BEW_CLEAR && stage != Stage::BEW_VERIFY) return;
+				if (!eeprom_is_ready()) return;
+				if (cell >= EEPROM.length()) {
+					stage	= (stage == Stage::BEW_CLEAR) ? Stage::BEW_VERIFY : Stage::BEW_DONE;
+					cell	= 0;
+					continue;
+				}
+				if (EEPROM.read(cell) == 0) {
+					++cell;
+					continue;
+				}
+				stage = Stage::BEW_CLEAR;
+				EEPROM.write(cell++, 0);
+				return;
+			}
+		}
+
+		/// @brief Returns whether a wipe is in progress.
+		bool busy() const		{return stage == Stage::BEW_CLEAR || stage == Stage::BEW_VERIFY;	}
+		/// @brief Returns whether a wipe finished, and was verified.
+		bool done() const		{return stage == Stage::BEW_DONE;									}
+		/// @brief Returns whether the wipe is reading back the EEPROM.
+		bool verifying() const	{return stage == Stage::BEW_VERIFY;									}
+
+		/// @brief Returns the progress of the current pass, in percent.
+		uint8 progress() const {
+			return static_cast<uint32>(cell) * 100 / EEPROM.length();
+		}
+
+	private:
+		/// @brief Current stage.
+		Stage	stage	= Stage::BEW_IDLE;
+		/// @brief Next cell to check.
+		uint16	cell	= 0;
+	};
+}
+
+#endif
@@ -0,0 +1,61 @@
+/// @file Signal filter checks. Failed readings must never pass for samples, nor hold back the real ones after them.
+
+#include <Arduino.h>
+#include <stdio.h>
+
+#include "bits/filter.hpp"
+
+using namespace Bits;
+
+namespace {
+	/// @brief The default channel pipeline.
+	using Pipeline = Filter<Filters::Reject<1000>, Filters::Median<3>>;
+
+	/// @brief Amount of failed checks.
+	uint32 failures	= 0;
+
+	#define EXPECT(condition) expect(condition, #condition, __LINE__)
+
+	void expect(bool const condition, char const* const what, int const line) {
+		if (condition) return;
+		++failures;
+		printf("filter.cpp:%d: expected %s\n", line, what);
+	}
+
+	/// @brief A failed first read yields no sample, and the first real reading goes straight through.
+	void testFailedFirstRead() {
+		Pipeline filter;
+		EXPECT(filter.push(Units::MISSING) == Units::MISSING);
+		EXPECT(filter.push(Units::MISSING) == Units::MISSING);
+		EXPECT(filter.push(2500) == 2500);
+		EXPECT(filter.push(2510) == 2510);
+	}
+
+	/// @brief A failed read later on keeps the last filtered value, and does not count as a jump.
+	void testFailedLaterRead() {
+		Pipeline filter;
+		filter.push(2500);
+		filter.push(2500);
+		EXPECT(filter.push(Units::MISSING) == 2500);
+		EXPECT(filter.push(2600) == 2500);
+		EXPECT(filter.push(2600) == 2600);
+	}
+
+	/// @brief Jumps are still dropped, up to the limit.
+	void testJump() {
+		Pipeline filter;
+		filter.push(2500);
+		EXPECT(filter.push(9000) == 2500);
+		EXPECT(filter.push(9000) == 2500);
+		EXPECT(filter.push(9000) == 2500);
+		EXPECT(filter.push(9000) != 2500);
+	}
+}
+
+int main() {
+	testFailedFirstRead();
+	testFailedLaterRead();
+	testJump();
+	printf("%u failed checks\n", failures);
+	return failures ? 1 : 0;
+}
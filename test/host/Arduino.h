@@ -0,0 +1,67 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+/// @file Minimal host-side stand-in for the Arduino core, covering what the storage bits need.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <string>
+
+#define F_CPU 16000000ul
+
+typedef uint8_t		byte;
+typedef uint16_t	word;
+typedef uint8_t		u8;
+typedef uint16_t	u16;
+typedef uint32_t	u32;
+typedef uint64_t	u64;
+
+#define _BV(bit) (1 << (bit))
+
+#define ISR(vector, ...) extern "C" void vector(void)
+
+inline void cli() {}
+inline void sei() {}
+
+/// @brief Time, in milliseconds. Stands still.
+inline unsigned long millis() {return 0;}
+
+/// @brief Timer registers, only written to.
+extern volatile uint8_t		SREG, TCCR1A, TCCR1B, TIMSK1;
+extern volatile uint16_t	TCNT1, OCR1A;
+
+/// @brief EEPROM address & data registers.
+extern volatile uint16_t	EEAR;
+extern volatile uint8_t		EEDR;
+
+/// @brief EEPROM control register. Reading (`EERE`) and writing (`EEPE`) act on the simulated EEPROM right away.
+struct HostEECR {
+	HostEECR& operator|=(uint8_t bits);
+	HostEECR& operator&=(uint8_t bits)	{value &= bits; return *this;	}
+	operator uint8_t() const			{return value;					}
+
+	uint8_t value = 0;
+};
+
+extern HostEECR EECR;
+
+enum {EERE = 0, EEPE = 1, EEMPE = 2, EERIE = 3, WGM12 = 3, OCIE1A = 1};
+
+/// @brief String, as far as the bits use it.
+struct String {
+	String(char const* str = "")	: str(str)						{}
+	String(std::string const& str)	: str(str)						{}
+	template <class T>
+	String(T const value)			: str(std::to_string(value))	{}
+
+	String& operator+=(String const& other)	{str += other.str; return *this;	}
+	friend String operator+(String lhs, String const& rhs)	{return lhs += rhs;	}
+
+	char const* c_str() const	{return str.c_str();	}
+	size_t length() const		{return str.size();		}
+
+	std::string str;
+};
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef HOST_EEPROM_H
+#define HOST_EEPROM_H
+
+/// @file Host-side simulated EEPROM, with power cut injection.
+
+#include "Arduino.h"
+
+/// @brief Simulated EEPROM, and power cut control.
+namespace Host {
+	/// @brief EEPROM size, in bytes.
+	constexpr uint16_t const EEPROM_LENGTH = 1024;
+
+	/// @brief Thrown when the power is cut.
+	struct PowerCut {};
+
+	/// @brief What a power cut leaves in the cell being written.
+	enum class Cut: uint8_t {
+		/// @brief The cell keeps its old value.
+		CLEAN,
+		/// @brief The cell holds garbage.
+		TORN,
+	};
+
+	/// @brief EEPROM contents.
+	extern uint8_t eeprom[EEPROM_LENGTH];
+	/// @brief Amount of byte writes so far.
+	extern long writes;
+	/// @brief Byte write the power is cut at, or `-1` to never cut it.
+	extern long cutAt;
+	/// @brief What the cut leaves behind.
+	extern Cut cut;
+
+	/// @brief Writes a byte, unless the power is cut right then.
+	void write(uint16_t address, uint8_t value);
+
+	/// @brief Arms a power cut at a given byte write, counting from now.
+	void armCut(long at, Cut how = Cut::CLEAN);
+
+	/// @brief Disarms the power cut.
+	void disarmCut();
+}
+
+/// @brief EEPROM library, as far as the bits use it.
+struct EEPROMClass {
+	void begin() {}
+
+	uint8_t read(int const address) const				{return Host::eeprom[address];	}
+	void write(int const address, uint8_t const value)	{Host::write(address, value);	}
+
+	void update(int const address, uint8_t const value) {
+		if (read(address) != value)
+			write(address, value);
+	}
+
+	uint16_t length() const {return Host::EEPROM_LENGTH;}
+
+	template <class T>
+	T& get(int const address, T& value) const {
+		memcpy(static_cast<void*>(&value), Host::eeprom + address, sizeof(T));
+		return value;
+	}
+
+	template <class T>
+	T const& put(int const address, T const& value) {
+		uint8_t const* const bytes = reinterpret_cast<uint8_t const*>(&value);
+		for (size_t i = 0; i < sizeof(T); ++i)
+			update(address + i, bytes[i]);
+		return value;
+	}
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
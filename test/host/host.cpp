@@ -0,0 +1,50 @@
+#include "Arduino.h"
+#include "EEPROM.h"
+
+volatile uint8_t	SREG, TCCR1A, TCCR1B, TIMSK1;
+volatile uint16_t	TCNT1, OCR1A;
+volatile uint16_t	EEAR;
+volatile uint8_t	EEDR;
+
+HostEECR	EECR;
+EEPROMClass	EEPROM;
+
+namespace Host {
+	uint8_t	eeprom[EEPROM_LENGTH];
+	long	writes	= 0;
+	long	cutAt	= -1;
+	Cut		cut		= Cut::CLEAN;
+
+	void write(uint16_t const address, uint8_t const value) {
+		if (cutAt >= 0 && writes >= cutAt) {
+			if (cut == Cut::TORN)
+				eeprom[address % EEPROM_LENGTH] = value ^ 0x5A;
+			throw PowerCut{};
+		}
+		++writes;
+		eeprom[address % EEPROM_LENGTH] = value;
+	}
+
+	void armCut(long const at, Cut const how) {
+		writes	= 0;
+		cutAt	= at;
+		cut		= how;
+	}
+
+	void disarmCut() {
+		cutAt = -1;
+	}
+}
+
+HostEECR& HostEECR::operator|=(uint8_t const bits) {
+	value |= bits;
+	if (bits & _BV(EERE)) {
+		EEDR = Host::eeprom[EEAR % Host::EEPROM_LENGTH];
+		value &= ~_BV(EERE);
+	}
+	if (bits & _BV(EEPE)) {
+		value &= ~(_BV(EEPE) | _BV(EEMPE));
+		Host::write(EEAR, EEDR);
+	}
+	return *this;
+}
@@ -0,0 +1,235 @@
+/// @file Power cut fault injection. Cuts the power at every byte write of each storage operation,
+/// then checks that what a reboot finds is either the state before the operation, or the state after it.
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <stdio.h>
+#include <vector>
+
+#include "bits/record.hpp"
+#include "bits/databank.hpp"
+#include "bits/retention.hpp"
+#include "bits/staging.hpp"
+
+using namespace Bits;
+
+namespace {
+	/// @brief Log entry, shaped like the data logger's.
+	struct PACKED Entry {
+		struct Value {
+			int16 a;
+			int16 b;
+		};
+
+		uint32	timestamp;
+		Value	value;
+		LogTag	tag;
+
+		bool operator==(Entry const& other) const {
+			return !memcmp(this, &other, sizeof(Entry));
+		}
+	};
+
+	using Bank		= DataBank<Entry, 32>;
+	using Entries	= std::vector<Entry>;
+
+	/// @brief Amount of failed checks.
+	uint32 failures	= 0;
+	/// @brief Amount of power cuts simulated.
+	uint32 cuts		= 0;
+
+	#define EXPECT(condition) expect(condition, #condition, __LINE__)
+
+	void expect(bool const condition, char const* const what, int const line) {
+		if (condition) return;
+		if (++failures <= 20)
+			printf("power-cut.cpp:%d: expected %s\n", line, what);
+	}
+
+	/// @brief Returns a sample entry.
+	Entry sample(uint32 const n) {
+		Entry e{};
+		e.timestamp	= 1000 + n;
+		e.value		= {static_cast<int16>(n * 3), static_cast<int16>(-n)};
+		return e;
+	}
+
+	/// @brief Returns every entry in a bank.
+	Entries contents(Bank const& bank) {
+		Entries entries;
+		for (uint16 i = 0; i < bank.size(); ++i)
+			entries.push_back(bank.get(i));
+		return entries;
+	}
+
+	/// @brief Returns the entries a bank holds after recording some more.
+	Entries recorded(Entries entries, Entries const& added, Bank const& bank) {
+		for (Entry const& e: added) {
+			if (entries.size() == bank.capacity())
+				entries.erase(entries.begin());
+			entries.push_back(e);
+		}
+		return entries;
+	}
+
+	/// @brief Wipes the EEPROM, as it comes out of the factory.
+	void erase() {
+		Host::disarmCut();
+		memset(Host::eeprom, 0xFF, sizeof(Host::eeprom));
+	}
+
+	/// @brief Runs an action, with the power cut at a given byte write.
+	/// @return Whether the action completed before the cut.
+	template <class F>
+	bool cutting(long const at, Host::Cut const how, F&& action) {
+		Host::armCut(at, how);
+		try {
+			action();
+		} catch (Host::PowerCut const&) {
+			Host::disarmCut();
+			++cuts;
+			return false;
+		}
+		Host::disarmCut();
+		return true;
+	}
+
+	/// @brief Runs a trial with the power cut at every byte write, in turn, until the trial completes uncut.
+	/// @param trial Trial, taking the byte write to cut at and the kind of cut, and returning whether it completed.
+	template <class F>
+	void forEachCut(F&& trial) {
+		for (Host::Cut how: {Host::Cut::CLEAN, Host::Cut::TORN})
+			for (long at = 0; !trial(at, how); ++at);
+	}
+
+	/// @brief `RecordStorage::store()`: a reboot finds either the old value, or the new one.
+	void testRecordStorage() {
+		using Storage = RecordStorage<Entry, 1>;
+		for (uint8 prior = 1; prior <= 3; ++prior)
+			forEachCut([&] (long const at, Host::Cut const how) {
+				erase();
+				Storage storage(16);
+				Entry loaded;
+				storage.load(loaded);
+				for (uint8 i = 0; i < prior; ++i)
+					storage.store(sample(i));
+				bool const done = cutting(at, how, [&] {storage.store(sample(100));});
+				Storage rebooted(16);
+				EXPECT(rebooted.load(loaded));
+				EXPECT(loaded == sample(100) || (!done && loaded == sample(prior - 1)));
+				rebooted.store(sample(200));
+				EXPECT(Storage(16).load(loaded) && loaded == sample(200));
+				return done;
+			});
+	}
+
+	/// @brief `DataBank::record()`: a reboot finds the bank either without the new entry, or with it.
+	void testDataBank() {
+		for (uint16 fill: {0, 5, 31, 32, 40})
+			forEachCut([&] (long const at, Host::Cut const how) {
+				erase();
+				Bank bank;
+				bank.begin();
+				for (uint16 i = 0; i < fill; ++i)
+					bank.record(sample(i));
+				Entries const before	= contents(bank);
+				Entries const after		= recorded(before, {sample(1000)}, bank);
+				bool const done = cutting(at, how, [&] {bank.record(sample(1000));});
+				Bank rebooted;
+				rebooted.begin();
+				EXPECT(rebooted.valid());
+				Entries const found = contents(rebooted);
+				EXPECT(found == after || (!done && found == before));
+				return done;
+			});
+	}
+
+	/// @brief `Staging::flush()`: a reboot finds the bank with the staged entries committed in order, up to some point.
+	void testStaging() {
+		Entries const staged = {sample(1000), sample(1001), sample(1002)};
+		for (uint16 fill: {0, 30, 32, 40})
+			forEachCut([&] (long const at, Host::Cut const how) {
+				erase();
+				Bank bank;
+				bank.begin();
+				for (uint16 i = 0; i < fill; ++i)
+					bank.record(sample(i));
+				Staging<Bank> staging(bank);
+				staging.begin();
+				for (Entry const& e: staged)
+					staging.record(e);
+				Entries const before = contents(bank);
+				bool const done = cutting(at, how, [&] {staging.flush();});
+				Bank rebooted;
+				rebooted.begin();
+				EXPECT(rebooted.valid());
+				Entries const found = contents(rebooted);
+				bool matched = false;
+				for (usize committed = done ? staged.size() : 0; committed <= staged.size(); ++committed)
+					matched |= found == recorded(before, Entries(staged.begin(), staged.begin() + committed), bank);
+				EXPECT(matched);
+				return done;
+			});
+	}
+
+	/// @brief `Retention`: a reboot finds a valid bank, of a size compaction actually went through, that keeps working.
+	void testRetention() {
+		using RetentionType = Retention<Bank, 4, 2>;
+		constexpr uint16 const FILL		= 31;
+		constexpr uint16 const UPDATES	= 400;
+		auto const prepare = [] (Bank& bank) {
+			erase();
+			bank.begin();
+			for (uint16 i = 0; i < FILL; ++i)
+				bank.record(sample(i));
+		};
+		std::vector<uint32> sizes;
+		{
+			Bank bank;
+			prepare(bank);
+			RetentionType retention(bank);
+			sizes.push_back(bank.size());
+			for (uint16 i = 0; i < UPDATES; ++i) {
+				retention.update();
+				sizes.push_back(bank.size());
+			}
+			EXPECT(!retention.busy());
+			EXPECT(bank.size() < FILL);
+		}
+		forEachCut([&] (long const at, Host::Cut const how) {
+			Bank bank;
+			prepare(bank);
+			RetentionType retention(bank);
+			bool const done = cutting(at, how, [&] {
+				for (uint16 i = 0; i < UPDATES; ++i)
+					retention.update();
+			});
+			Bank rebooted;
+			rebooted.begin();
+			EXPECT(rebooted.valid());
+			bool known = false;
+			for (uint32 const size: sizes)
+				known |= rebooted.size() == size;
+			EXPECT(known);
+			RetentionType resumed(rebooted);
+			for (uint16 i = 0; i < 3 * UPDATES; ++i) {
+				if (!(i % 8)) rebooted.record(sample(2000 + i));
+				resumed.update();
+			}
+			EXPECT(rebooted.size() < rebooted.capacity());
+			Bank checked;
+			checked.begin();
+			EXPECT(checked.valid() && checked.size() == rebooted.size());
+			return done;
+		});
+	}
+}
+
+int main() {
+	testRecordStorage();
+	testDataBank();
+	testStaging();
+	testRetention();
+	printf("%u power cuts, %u failed checks\n", cuts, failures);
+	return failures ? 1 : 0;
+}